@@ -0,0 +1,247 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miCellId.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+namespace {
+
+const uint32_t MAX_SIZE = uint32_t(1) << miCellId::MAX_LEVEL;
+
+// spread the lower 32 bits of v to the even bits
+uint64_t spreadBits(uint64_t v)
+{
+  v &= 0xFFFFFFFFull;
+  v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+  v = (v | (v <<  8)) & 0x00FF00FF00FF00FFull;
+  v = (v | (v <<  4)) & 0x0F0F0F0F0F0F0F0Full;
+  v = (v | (v <<  2)) & 0x3333333333333333ull;
+  v = (v | (v <<  1)) & 0x5555555555555555ull;
+  return v;
+}
+
+// inverse of spreadBits
+uint32_t compactBits(uint64_t v)
+{
+  v &= 0x5555555555555555ull;
+  v = (v | (v >>  1)) & 0x3333333333333333ull;
+  v = (v | (v >>  2)) & 0x0F0F0F0F0F0F0F0Full;
+  v = (v | (v >>  4)) & 0x00FF00FF00FF00FFull;
+  v = (v | (v >>  8)) & 0x0000FFFF0000FFFFull;
+  v = (v | (v >> 16)) & 0x00000000FFFFFFFFull;
+  return uint32_t(v);
+}
+
+uint32_t clampCell(double f)
+{
+  if (!(f > 0))
+    return 0;
+  if (f >= MAX_SIZE)
+    return MAX_SIZE - 1;
+  return uint32_t(f);
+}
+
+// number of trailing zero bits, for v != 0
+int trailingZeros(uint64_t v)
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(v);
+#else
+  int n = 0;
+  while ((v & 1) == 0) {
+    v >>= 1;
+    n += 1;
+  }
+  return n;
+#endif
+}
+
+} // namespace
+
+miCellId miCellId::fromIJ(uint32_t i, uint32_t j, int level)
+{
+  const uint64_t morton = (spreadBits(i) << 1) | spreadBits(j);
+  return miCellId(((morton << 1) | 1) << (2*(MAX_LEVEL - level)));
+}
+
+miCellId miCellId::fromDegrees(double lon, double lat, int level)
+{
+  lon = std::fmod(lon + 180, 360);
+  if (lon < 0)
+    lon += 360;
+  const uint32_t i = clampCell(lon / 360 * MAX_SIZE);
+  const uint32_t j = clampCell((lat + 90) / 180 * MAX_SIZE);
+  return fromIJ(i, j, MAX_LEVEL).parent(level);
+}
+
+miCellId miCellId::fromLonLat(const LonLat& ll, int level)
+{
+  return fromDegrees(ll.lonDeg(), ll.latDeg(), level);
+}
+
+miCellId miCellId::fromCoordinates(const miCoordinates& c, int level)
+{
+  const int64_t LON_CMIN = 360*6000, LAT_CMIN = 180*6000;
+  int64_t lon = (int64_t(c.Lon().deg)*6000 + c.Lon().cmin + LON_CMIN/2) % LON_CMIN;
+  if (lon < 0)
+    lon += LON_CMIN;
+  int64_t lat = int64_t(c.Lat().deg)*6000 + c.Lat().cmin + LAT_CMIN/2;
+  lat = std::min(std::max(lat, int64_t(0)), LAT_CMIN - 1);
+  const uint32_t i = uint32_t((lon << MAX_LEVEL) / LON_CMIN);
+  const uint32_t j = uint32_t((lat << MAX_LEVEL) / LAT_CMIN);
+  return fromIJ(i, j, MAX_LEVEL).parent(level);
+}
+
+bool miCellId::isValid() const
+{
+  // marker bit at an even position and nothing above the top level
+  return mId != 0 && (trailingZeros(mId) % 2) == 0 && (mId >> (2*MAX_LEVEL + 1)) == 0;
+}
+
+int miCellId::level() const
+{
+  return MAX_LEVEL - trailingZeros(mId) / 2;
+}
+
+void miCellId::getIJ(uint32_t& i, uint32_t& j) const
+{
+  const uint64_t morton = mId >> (trailingZeros(mId) + 1);
+  i = compactBits(morton >> 1);
+  j = compactBits(morton);
+}
+
+void miCellId::bounds(double& lonMin, double& latMin, double& lonMax, double& latMax) const
+{
+  uint32_t i, j;
+  getIJ(i, j);
+  const double size = double(uint64_t(1) << level());
+  lonMin = i / size * 360 - 180;
+  lonMax = (i + 1) / size * 360 - 180;
+  latMin = j / size * 180 - 90;
+  latMax = (j + 1) / size * 180 - 90;
+}
+
+miCellId miCellId::parent() const
+{
+  const uint64_t newLsb = lsb() << 2;
+  return miCellId((mId & (~newLsb + 1)) | newLsb);
+}
+
+miCellId miCellId::parent(int level) const
+{
+  const uint64_t newLsb = lsbForLevel(level);
+  return miCellId((mId & (~newLsb + 1)) | newLsb);
+}
+
+miCellId miCellId::child(int k) const
+{
+  const uint64_t newLsb = lsb() >> 2;
+  return miCellId(mId - lsb() + (2*k + 1) * newLsb);
+}
+
+miCellId miCellId::neighbour(int di, int dj) const
+{
+  uint32_t i, j;
+  getIJ(i, j);
+  const int lvl = level();
+  const int64_t size = int64_t(1) << lvl;
+  const int64_t nj = int64_t(j) + dj;
+  if (nj < 0 || nj >= size)
+    return miCellId();
+  int64_t ni = (int64_t(i) + di) % size;
+  if (ni < 0)
+    ni += size;
+  return fromIJ(uint32_t(ni), uint32_t(nj), lvl);
+}
+
+void miCellId::neighbours(std::vector<miCellId>& cells) const
+{
+  cells.clear();
+  for (int dj = -1; dj <= 1; ++dj) {
+    for (int di = -1; di <= 1; ++di) {
+      if (di == 0 && dj == 0)
+        continue;
+      const miCellId n = neighbour(di, dj);
+      if (n.isValid() && n != *this && std::find(cells.begin(), cells.end(), n) == cells.end())
+        cells.push_back(n);
+    }
+  }
+}
+
+void miCellId::cover(double lonMin, double latMin, double lonMax, double latMax,
+    int maxLevel, std::size_t maxCells, std::vector<miCellId>& cells)
+{
+  cells.clear();
+  // lonMin > lonMax means [lonMin, 180] and [-180, lonMax]
+  const bool wraps = (lonMin > lonMax);
+  std::deque<miCellId> candidates;
+  candidates.push_back(fromIJ(0, 0, 0));
+  while (!candidates.empty()) {
+    const miCellId c = candidates.front();
+    candidates.pop_front();
+
+    double cLonMin, cLatMin, cLonMax, cLatMax;
+    c.bounds(cLonMin, cLatMin, cLonMax, cLatMax);
+    if (cLatMin > latMax || cLatMax < latMin)
+      continue;
+    bool overlaps, lonInside;
+    if (wraps) {
+      overlaps = (cLonMax >= lonMin || cLonMin <= lonMax);
+      lonInside = (cLonMin >= lonMin || cLonMax <= lonMax);
+    } else {
+      overlaps = (cLonMin <= lonMax && cLonMax >= lonMin);
+      lonInside = (cLonMin >= lonMin && cLonMax <= lonMax);
+    }
+    if (!overlaps)
+      continue;
+    const bool inside = (lonInside && cLatMin >= latMin && cLatMax <= latMax);
+    if (inside || c.level() >= maxLevel) {
+      cells.push_back(c);
+      continue;
+    }
+
+    // breadth-first, so that running out of cells leaves a uniformly coarser covering
+    if (maxCells > 0 && cells.size() + candidates.size() + 4 > maxCells) {
+      cells.push_back(c);
+      continue;
+    }
+    for (int k = 0; k < 4; ++k)
+      candidates.push_back(c.child(k));
+  }
+  std::sort(cells.begin(), cells.end());
+}
+
+bool miCellId::covers(const std::vector<miCellId>& cells, const miCellId& id)
+{
+  // first cell whose range ends at or after id
+  std::vector<miCellId>::const_iterator it = std::lower_bound(cells.begin(), cells.end(), id,
+      [](const miCellId& c, const miCellId& i) { return c.rangeMax() < i.id(); });
+  return it != cells.end() && it->contains(id);
+}
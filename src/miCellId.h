@@ -0,0 +1,141 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miCellId_h
+#define puDatatypes_miCellId_h
+
+#include "miCoordinates.h"
+
+#include <cstdint>
+#include <vector>
+
+/*! Hierarchical cell on a longitude/latitude quadtree, encoded in 64 bits.
+ *
+ *  Level 0 is the whole globe and each level halves a cell in longitude
+ *  and latitude. At MAX_LEVEL a cell is about 4 cm wide, much finer than
+ *  the centiminutes of miCoordinates.
+ *
+ *  The id interleaves the longitude and latitude cell numbers (Z-order,
+ *  as in geohash), followed by a marker bit that encodes the level, as in
+ *  S2 cell ids. Thus sorting by id is sorting along the Z curve, and all
+ *  descendants of a cell have ids between rangeMin() and rangeMax().
+ *  Computing an id needs no trigonometry.
+ */
+class miCellId {
+public:
+  enum { MAX_LEVEL = 30 };
+
+  //! invalid cell
+  miCellId()
+    : mId(0) { }
+  explicit miCellId(uint64_t id)
+    : mId(id) { }
+
+  //! cell number 'i' in longitude and 'j' in latitude, each in [0, 2^level)
+  static miCellId fromIJ(uint32_t i, uint32_t j, int level);
+
+  //! cell containing lon/lat given in degrees
+  static miCellId fromDegrees(double lon, double lat, int level = MAX_LEVEL);
+
+  //! cell containing 'll'
+  static miCellId fromLonLat(const LonLat& ll, int level = MAX_LEVEL);
+
+  //! cell containing 'c', computed in integer arithmetic from the centiminutes
+  static miCellId fromCoordinates(const miCoordinates& c, int level = MAX_LEVEL);
+
+  uint64_t id() const
+    { return mId; }
+
+  bool isValid() const;
+
+  int level() const;
+
+  //! cell numbers in longitude and latitude at level()
+  void getIJ(uint32_t& i, uint32_t& j) const;
+
+  //! cell boundaries in degrees
+  void bounds(double& lonMin, double& latMin, double& lonMax, double& latMax) const;
+
+  miCellId parent() const;
+  //! ancestor at 'level', which must not be larger than level()
+  miCellId parent(int level) const;
+
+  //! child 'k', 0 <= k < 4, in id order
+  miCellId child(int k) const;
+
+  //! neighbour 'di' cells east and 'dj' cells north at the same level;
+  //! wraps in longitude, invalid beyond the poles
+  miCellId neighbour(int di, int dj) const;
+
+  //! the up to 8 cells around this one, without invalid ones
+  void neighbours(std::vector<miCellId>& cells) const;
+
+  //! smallest id of all descendants (at MAX_LEVEL)
+  uint64_t rangeMin() const
+    { return mId - (lsb() - 1); }
+  //! largest id of all descendants (at MAX_LEVEL)
+  uint64_t rangeMax() const
+    { return mId + (lsb() - 1); }
+
+  //! true if 'other' is this cell or one of its descendants
+  bool contains(const miCellId& other) const
+    { return other.mId >= rangeMin() && other.mId <= rangeMax(); }
+
+  /*! cells covering the rectangle [lonMin, lonMax] x [latMin, latMax] in degrees
+   *
+   *  Cells completely inside the rectangle are not subdivided. Cells on
+   *  the boundary are subdivided down to 'maxLevel', unless this would
+   *  give more than 'maxCells' cells (if maxCells > 0). The result is
+   *  sorted by id.
+   *
+   *  Longitudes must be in [-180, 180]. A rectangle crossing the dateline
+   *  is given with lonMin > lonMax, e.g. [170, -170].
+   */
+  static void cover(double lonMin, double latMin, double lonMax, double latMax,
+      int maxLevel, std::size_t maxCells, std::vector<miCellId>& cells);
+
+  //! true if one of the sorted, non-overlapping 'cells' contains 'id', as given by cover
+  static bool covers(const std::vector<miCellId>& cells, const miCellId& id);
+
+  friend bool operator==(const miCellId& a, const miCellId& b)
+    { return a.mId == b.mId; }
+  friend bool operator!=(const miCellId& a, const miCellId& b)
+    { return a.mId != b.mId; }
+  friend bool operator<(const miCellId& a, const miCellId& b)
+    { return a.mId < b.mId; }
+
+private:
+  uint64_t lsb() const
+    { return mId & (~mId + 1); }
+  static uint64_t lsbForLevel(int level)
+    { return uint64_t(1) << (2*(MAX_LEVEL - level)); }
+
+  uint64_t mId;
+};
+
+#endif // puDatatypes_miCellId_h
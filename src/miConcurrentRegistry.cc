@@ -0,0 +1,163 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miConcurrentRegistry.h"
+
+#include <algorithm>
+#include <thread>
+
+// one per Reader, on its own cache line so that readers do not contend
+struct alignas(64) miConcurrentRegistry::Slot {
+  std::atomic<uint64_t> epoch; //!< epoch when the current Snapshot was taken, 0 if none
+  std::atomic<bool> used;
+  Slot* next;
+
+  Slot() : epoch(0), used(true), next(0) { }
+};
+
+/* ====== Reader ====== */
+
+miConcurrentRegistry::Reader::Reader(miConcurrentRegistry& registry)
+  : mRegistry(&registry)
+  , mSlot(registry.acquireSlot())
+{
+}
+
+miConcurrentRegistry::Reader::~Reader()
+{
+  mSlot->used.store(false, std::memory_order_release);
+}
+
+/* ====== Snapshot ====== */
+
+miConcurrentRegistry::Snapshot::Snapshot(Reader& reader)
+  : mSlot(reader.mSlot)
+{
+  // announce the epoch before loading the pointer; a writer that does
+  // not see this store exchanged the pointer before it, see reclaim()
+  mSlot->epoch.store(reader.mRegistry->mEpoch.load());
+  mRegistry = reader.mRegistry->mCurrent.load();
+}
+
+miConcurrentRegistry::Snapshot::~Snapshot()
+{
+  mSlot->epoch.store(0, std::memory_order_release);
+}
+
+/* ====== miConcurrentRegistry ====== */
+
+miConcurrentRegistry::miConcurrentRegistry()
+  : mCurrent(new miStationRegistry)
+  , mEpoch(1)
+  , mSlots(0)
+{
+}
+
+miConcurrentRegistry::miConcurrentRegistry(miStationRegistry registry)
+  : mCurrent(new miStationRegistry(std::move(registry)))
+  , mEpoch(1)
+  , mSlots(0)
+{
+}
+
+miConcurrentRegistry::~miConcurrentRegistry()
+{
+  delete mCurrent.load();
+  for (std::size_t i = 0; i < mRetired.size(); ++i)
+    delete mRetired[i].registry;
+  Slot* s = mSlots.load();
+  while (s) {
+    Slot* next = s->next;
+    delete s;
+    s = next;
+  }
+}
+
+miConcurrentRegistry::Slot* miConcurrentRegistry::acquireSlot()
+{
+  for (Slot* s = mSlots.load(); s; s = s->next) {
+    bool unused = false;
+    if (!s->used.load(std::memory_order_relaxed) && s->used.compare_exchange_strong(unused, true))
+      return s;
+  }
+  Slot* s = new Slot;
+  s->next = mSlots.load();
+  while (!mSlots.compare_exchange_weak(s->next, s))
+    ;
+  return s;
+}
+
+void miConcurrentRegistry::publish(miStationRegistry registry)
+{
+  const miStationRegistry* fresh = new miStationRegistry(std::move(registry));
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  const miStationRegistry* old = mCurrent.exchange(fresh);
+  // snapshots announcing this epoch or later see 'fresh'
+  const uint64_t epoch = mEpoch.fetch_add(1) + 1;
+  Retired r = { epoch, old };
+  mRetired.push_back(r);
+  reclaim();
+}
+
+void miConcurrentRegistry::reclaim()
+{
+  // the oldest epoch of any active snapshot
+  uint64_t oldest = ~uint64_t(0);
+  for (Slot* s = mSlots.load(); s; s = s->next) {
+    const uint64_t e = s->epoch.load();
+    if (e != 0)
+      oldest = std::min(oldest, e);
+  }
+
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < mRetired.size(); ++i) {
+    if (mRetired[i].epoch <= oldest)
+      delete mRetired[i].registry;
+    else
+      mRetired[kept++] = mRetired[i];
+  }
+  mRetired.resize(kept);
+}
+
+void miConcurrentRegistry::synchronize()
+{
+  std::unique_lock<std::mutex> lock(mWriteMutex);
+  reclaim();
+  while (!mRetired.empty()) {
+    lock.unlock();
+    std::this_thread::yield();
+    lock.lock();
+    reclaim();
+  }
+}
+
+std::size_t miConcurrentRegistry::retired() const
+{
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  return mRetired.size();
+}
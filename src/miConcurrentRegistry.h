@@ -0,0 +1,133 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miConcurrentRegistry_h
+#define puDatatypes_miConcurrentRegistry_h
+
+#include "miStationRegistry.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/*! Station registry that can be replaced while other threads read it.
+ *
+ *  publish() swaps in a new immutable miStationRegistry with an atomic
+ *  pointer exchange. Readers pin the current registry with a Snapshot,
+ *  which costs two atomic stores and a load: readers never lock, wait or
+ *  allocate. A replaced registry is deleted by a later publish() or
+ *  synchronize() once no Snapshot taken before the exchange remains
+ *  (epoch-based reclamation).
+ *
+ *  Each reading thread needs its own Reader, which registers a slot
+ *  when created; slots are reused after the Reader is destroyed.
+ */
+class miConcurrentRegistry {
+private:
+  struct Slot;
+
+public:
+  class Snapshot;
+
+  class Reader {
+  public:
+    explicit Reader(miConcurrentRegistry& registry);
+    ~Reader();
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+  private:
+    friend class miConcurrentRegistry::Snapshot;
+    miConcurrentRegistry* mRegistry;
+    Slot* mSlot;
+  };
+
+  //! the current registry, pinned until the Snapshot is destroyed; one at a time per Reader
+  class Snapshot {
+  public:
+    explicit Snapshot(Reader& reader);
+    ~Snapshot();
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    const miStationRegistry& operator*() const
+      { return *mRegistry; }
+    const miStationRegistry* operator->() const
+      { return mRegistry; }
+
+  private:
+    Slot* mSlot;
+    const miStationRegistry* mRegistry;
+  };
+
+  miConcurrentRegistry();
+  explicit miConcurrentRegistry(miStationRegistry registry);
+
+  //! all Readers must be destroyed before the registry
+  ~miConcurrentRegistry();
+
+  miConcurrentRegistry(const miConcurrentRegistry&) = delete;
+  miConcurrentRegistry& operator=(const miConcurrentRegistry&) = delete;
+
+  /*! replace the current registry and delete replaced ones no longer read
+   *
+   *  Station names, groups and ICAO ids are miSymbol, which are never
+   *  freed: deleting a replaced registry does not release its strings.
+   *  Republishing names seen before costs nothing, but each new distinct
+   *  name stays in memory until the process exits.
+   */
+  void publish(miStationRegistry registry);
+
+  //! wait until all replaced registries are deleted
+  void synchronize();
+
+  //! number of replaced registries not deleted yet
+  std::size_t retired() const;
+
+private:
+  struct Retired {
+    uint64_t epoch;
+    const miStationRegistry* registry;
+  };
+
+  Slot* acquireSlot();
+  void reclaim();
+
+private:
+  std::atomic<const miStationRegistry*> mCurrent;
+  std::atomic<uint64_t> mEpoch;
+  std::atomic<Slot*> mSlots; //!< singly linked, never shrinks
+
+  mutable std::mutex mWriteMutex;
+  std::vector<Retired> mRetired;
+};
+
+#endif // puDatatypes_miConcurrentRegistry_h
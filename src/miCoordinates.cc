@@ -29,20 +29,77 @@
 
 #include "miCoordinates.h"
 
-#include <sstream>
+#include "miParse.h"
+
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 
-#include <boost/lexical_cast.hpp>
-#include <boost/algorithm/string.hpp>
-
-#include <exception>
+#include <charconv>
 
 
 extern const double EARTH_RADIUS_M = 6371000.0;
 static const double RAD_TO_DEG = (180.0/M_PI);
 static const double DEG_TO_RAD = 1.0/RAD_TO_DEG;
 
+namespace {
+
+// DISTANCE_EQUIRECTANGULAR uses the haversine formula beyond this latitude
+const double EQUIRECTANGULAR_MAX_LAT = 80 * DEG_TO_RAD;
+
+// sin for |x| <= pi/2, taylor series with error below 1e-11
+inline double polySin(double x)
+{
+  const double x2 = x*x;
+  return x*(1 + x2*(-1.0/6 + x2*(1.0/120 + x2*(-1.0/5040 + x2*(1.0/362880
+      + x2*(-1.0/39916800 + x2*(1.0/6227020800 + x2*(-1.0/1307674368000))))))));
+}
+
+// asin for 0 <= x <= 0.5, taylor series with error below 1e-9
+inline double polyAsinSmall(double x)
+{
+  const double x2 = x*x;
+  return x*(1 + x2*(1.0/6 + x2*(3.0/40 + x2*(5.0/112 + x2*(35.0/1152 + x2*(63.0/2816
+      + x2*(231.0/13312 + x2*(143.0/10240 + x2*(6435.0/557056 + x2*(12155.0/1245184
+      + x2*(46189.0/5505024)))))))))));
+}
+
+// asin for 0 <= x <= 1
+inline double polyAsin(double x)
+{
+  if (x <= 0.5)
+    return polyAsinSmall(x);
+  return M_PI/2 - 2*polyAsinSmall(std::sqrt((1 - std::min(x, 1.0)) / 2));
+}
+
+// wrap a longitude difference into [-pi, pi]
+inline double wrapLon(double dlon)
+{
+  if (dlon > M_PI)
+    return dlon - 2*M_PI*std::floor((dlon + M_PI) / (2*M_PI));
+  if (dlon < -M_PI)
+    return dlon + 2*M_PI*std::floor((M_PI - dlon) / (2*M_PI));
+  return dlon;
+}
+
+} // namespace
+
+double chord2ForDistance(double distance)
+{
+  if (distance <= 0)
+    return 0;
+  if (distance >= M_PI * EARTH_RADIUS_M)
+    return std::numeric_limits<double>::infinity();
+  const double h = std::sin(distance / (2 * EARTH_RADIUS_M));
+  return 4 * h * h;
+}
+
+double distanceForChord2(double chord2)
+{
+  return 2 * EARTH_RADIUS_M * std::asin(std::min(std::sqrt(chord2) / 2, 1.0));
+}
+
 double LonLat::lonDeg() const
 {
   return mLon * RAD_TO_DEG;
@@ -72,6 +129,53 @@ double LonLat::distanceTo(const LonLat& to) const
   return EARTH_RADIUS_M * c;
 }
 
+double LonLat::distanceTo(const LonLat& to, DistanceMode mode) const
+{
+  switch (mode) {
+  case DISTANCE_EQUIRECTANGULAR: {
+    // near the poles the projection has no useful error bound
+    if (std::fabs(lat()) > EQUIRECTANGULAR_MAX_LAT || std::fabs(to.lat()) > EQUIRECTANGULAR_MAX_LAT)
+      return distanceTo(to);
+    const double x = wrapLon(to.lon() - lon()) * std::cos((lat() + to.lat()) / 2);
+    const double y = to.lat() - lat();
+    return EARTH_RADIUS_M * std::sqrt(x*x + y*y);
+  }
+  case DISTANCE_CHORD: {
+    // the haversine term is a quarter of the squared chord
+    const double sinlat = std::sin((to.lat() - lat()) / 2);
+    const double sinlon = std::sin((to.lon() - lon()) / 2);
+    const double a = sinlat * sinlat + std::cos(lat()) * std::cos(to.lat()) * sinlon * sinlon;
+    return 2 * EARTH_RADIUS_M * std::sqrt(a);
+  }
+  case DISTANCE_POLYNOMIAL: {
+    const double sinlat = polySin((to.lat() - lat()) / 2);
+    const double sinlon = polySin(wrapLon(to.lon() - lon()) / 2);
+    const double clat1 = polySin(M_PI/2 - std::fabs(lat()));
+    const double clat2 = polySin(M_PI/2 - std::fabs(to.lat()));
+    const double a = sinlat * sinlat + clat1 * clat2 * sinlon * sinlon;
+    return 2 * EARTH_RADIUS_M * polyAsin(std::sqrt(a));
+  }
+  case DISTANCE_HAVERSINE:
+  default:
+    return distanceTo(to);
+  }
+}
+
+void LonLat::distancesTo(const double* lons, const double* lats, std::size_t count, double* distances) const
+{
+  // same haversine as distanceTo, but with 2*asin(sqrt(a)) instead of
+  // 2*atan2(sqrt(a), sqrt(1-a)), which saves one sqrt and the atan2
+  const double lon1 = lon();
+  const double lat1 = lat();
+  const double clat1 = std::cos(lat1);
+  for (std::size_t i = 0; i < count; ++i) {
+    const double sinlat = std::sin((lats[i] - lat1) / 2);
+    const double sinlon = std::sin((lons[i] - lon1) / 2);
+    const double a = sinlat * sinlat + clat1 * std::cos(lats[i]) * sinlon * sinlon;
+    distances[i] = 2 * EARTH_RADIUS_M * std::asin(std::sqrt(std::min(a, 1.0)));
+  }
+}
+
 double LonLat::bearingTo(const LonLat& to) const
 {
   // source: http://www.movable-type.co.uk/scripts/latlong.html
@@ -95,6 +199,202 @@ LonLat LonLat::stepDirection(double distance, double bearing) const
   return LonLat(lon2, lat2);
 }
 
+/*
+  ===================================================
+                 PreparedLonLat
+  ===================================================
+*/
+
+namespace {
+
+inline double normalizedBearing(double y, double x)
+{
+  return fmod(std::atan2(y, x) + 2*M_PI, 2*M_PI);
+}
+
+} // namespace
+
+PreparedLonLat::PreparedLonLat(const LonLat& ll)
+  : mLonLat(ll)
+  , mSinLat(std::sin(ll.lat()))
+  , mCosLat(std::cos(ll.lat()))
+  , mSinLon(std::sin(ll.lon()))
+  , mCosLon(std::cos(ll.lon()))
+{
+}
+
+double PreparedLonLat::distanceTo(const LonLat& to) const
+{
+  const double sinlat = std::sin((to.lat() - lat()) / 2);
+  const double sinlon = std::sin((to.lon() - lon()) / 2);
+  const double a = sinlat * sinlat + mCosLat * std::cos(to.lat()) * sinlon * sinlon;
+  return 2 * EARTH_RADIUS_M * std::asin(std::sqrt(std::min(a, 1.0)));
+}
+
+double PreparedLonLat::chord2To(const PreparedLonLat& to) const
+{
+  // chord between the unit vectors; this is accurate also for short distances
+  const double dx = mCosLat*mCosLon - to.mCosLat*to.mCosLon;
+  const double dy = mCosLat*mSinLon - to.mCosLat*to.mSinLon;
+  const double dz = mSinLat - to.mSinLat;
+  return dx*dx + dy*dy + dz*dz;
+}
+
+double PreparedLonLat::distanceTo(const PreparedLonLat& to) const
+{
+  return distanceForChord2(chord2To(to));
+}
+
+void PreparedLonLat::unitVector(double xyz[3]) const
+{
+  xyz[0] = mCosLat*mCosLon;
+  xyz[1] = mCosLat*mSinLon;
+  xyz[2] = mSinLat;
+}
+
+double PreparedLonLat::bearingTo(const LonLat& to) const
+{
+  const double dLon = (to.lon() - lon());
+  const double clat2 = std::cos(to.lat());
+  const double y = std::sin(dLon) * clat2;
+  const double x = mCosLat*std::sin(to.lat()) - mSinLat*clat2*std::cos(dLon);
+  return normalizedBearing(y, x);
+}
+
+double PreparedLonLat::bearingTo(const PreparedLonLat& to) const
+{
+  const double sin_dlon = to.mSinLon*mCosLon - to.mCosLon*mSinLon;
+  const double cos_dlon = to.mCosLon*mCosLon + to.mSinLon*mSinLon;
+  const double y = sin_dlon * to.mCosLat;
+  const double x = mCosLat*to.mSinLat - mSinLat*to.mCosLat*cos_dlon;
+  return normalizedBearing(y, x);
+}
+
+void PreparedLonLat::distanceAndBearingTo(const LonLat& to, double& distance, double& bearing) const
+{
+  const double dLon = (to.lon() - lon());
+  const double slat2 = std::sin(to.lat()), clat2 = std::cos(to.lat());
+  const double sin_dlon = std::sin(dLon), cos_dlon = std::cos(dLon);
+
+  // unit vectors in a frame rotated to put this point at longitude 0
+  const double dx = mCosLat - clat2*cos_dlon;
+  const double dy = clat2*sin_dlon;
+  const double dz = mSinLat - slat2;
+  distance = distanceForChord2(dx*dx + dy*dy + dz*dz);
+  bearing = normalizedBearing(sin_dlon * clat2, mCosLat*slat2 - mSinLat*clat2*cos_dlon);
+}
+
+void PreparedLonLat::distanceAndBearingTo(const PreparedLonLat& to, double& distance, double& bearing) const
+{
+  distance = distanceTo(to);
+  bearing = bearingTo(to);
+}
+
+LonLat PreparedLonLat::stepDirection(double distance, double bearing) const
+{
+  const double dr = distance/EARTH_RADIUS_M, sin_dr = std::sin(dr), cos_dr = std::cos(dr);
+  const double sin_lat2 = mSinLat*cos_dr + mCosLat*sin_dr*std::cos(bearing), lat2 = std::asin(sin_lat2);
+  const double lon2 = lon() + std::atan2(std::sin(bearing)*sin_dr*mCosLat, cos_dr-mSinLat*sin_lat2);
+  return LonLat(lon2, lat2);
+}
+
+/*
+  ===================================================
+                 GreatCircle
+  ===================================================
+*/
+
+GreatCircle::GreatCircle(const LonLat& from, const LonLat& to)
+{
+  const PreparedLonLat pfrom(from);
+  double distance, bearing;
+  pfrom.distanceAndBearingTo(to, distance, bearing);
+  *this = GreatCircle(from, bearing, distance / EARTH_RADIUS_M);
+}
+
+GreatCircle::GreatCircle(const LonLat& from, double bearing, double angle)
+  : mFrom(from)
+  , mSinLat(std::sin(from.lat()))
+  , mCosLat(std::cos(from.lat()))
+  , mAngle(angle)
+{
+  // north is (-sinlat, 0, coslat) and east is (0, 1, 0) at longitude 0
+  const double cb = std::cos(bearing), sb = std::sin(bearing);
+  mDirX = -mSinLat*cb;
+  mDirY = sb;
+  mDirZ = mCosLat*cb;
+}
+
+GreatCircle GreatCircle::fromBearing(const LonLat& from, double bearing)
+{
+  return GreatCircle(from, bearing, 0);
+}
+
+LonLat GreatCircle::pointAtAngle(double cos_a, double sin_a) const
+{
+  const double x = mCosLat*cos_a + mDirX*sin_a;
+  const double y = mDirY*sin_a;
+  const double z = mSinLat*cos_a + mDirZ*sin_a;
+  return LonLat(mFrom.lon() + std::atan2(y, x), std::atan2(z, std::sqrt(x*x + y*y)));
+}
+
+LonLat GreatCircle::pointAt(double distance) const
+{
+  const double a = distance / EARTH_RADIUS_M;
+  return pointAtAngle(std::cos(a), std::sin(a));
+}
+
+std::size_t GreatCircle::countForSpacing(double spacing) const
+{
+  if (spacing <= 0)
+    return 2;
+  return 1 + std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(length() / spacing)));
+}
+
+void GreatCircle::stepAngles(double angle0, double dangle, std::size_t count, LonLat* points) const
+{
+  // rotate by dangle for each point; restart from exact sin/cos
+  // regularly to keep the accumulated roundoff small
+  const std::size_t RESTART = 64;
+  const double cd = std::cos(dangle), sd = std::sin(dangle);
+  double ca = 0, sa = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i % RESTART == 0) {
+      const double a = angle0 + i*dangle;
+      ca = std::cos(a);
+      sa = std::sin(a);
+    } else {
+      const double c = ca*cd - sa*sd;
+      sa = sa*cd + ca*sd;
+      ca = c;
+    }
+    points[i] = pointAtAngle(ca, sa);
+  }
+}
+
+void GreatCircle::interpolate(std::size_t count, LonLat* points) const
+{
+  if (count == 0)
+    return;
+  if (count == 1) {
+    points[0] = mFrom;
+    return;
+  }
+  stepAngles(0, mAngle / (count - 1), count, points);
+  points[0] = mFrom;
+}
+
+void GreatCircle::stepEvery(double spacing, std::size_t count, LonLat* points) const
+{
+  stepAngles(0, spacing / EARTH_RADIUS_M, count, points);
+}
+
+void GreatCircle::stepDirections(const double* distances, std::size_t count, LonLat* points) const
+{
+  for (std::size_t i = 0; i < count; ++i)
+    points[i] = pointAt(distances[i]);
+}
+
 /*
   ===================================================
                  coor
@@ -163,7 +463,7 @@ bool coor::round(int r, bool best)
 
 bool operator==(const coor& rhs,const coor& lhs)
 {
-  return ( rhs.fCoor() == lhs.fCoor() );
+  return ( rhs.totalCmin() == lhs.totalCmin() );
 }
 
 bool operator!=(const coor& rhs,const coor& lhs)
@@ -173,7 +473,7 @@ bool operator!=(const coor& rhs,const coor& lhs)
 
 bool operator>(const coor& rhs,const coor& lhs)
 {
-  return ( rhs.fCoor() > lhs.fCoor() );
+  return ( rhs.totalCmin() > lhs.totalCmin() );
 }
 
 bool operator<(const coor& rhs,const coor& lhs)
@@ -183,12 +483,12 @@ bool operator<(const coor& rhs,const coor& lhs)
 
 bool operator>=(const coor& rhs,const coor& lhs)
 {
-  return ( rhs.fCoor() >= lhs.fCoor() );
+  return ( rhs.totalCmin() >= lhs.totalCmin() );
 }
 
 bool operator<=(const coor& rhs,const coor& lhs)
 {
-  return ( rhs.fCoor() <= lhs.fCoor() );
+  return ( rhs.totalCmin() <= lhs.totalCmin() );
 }
 
 
@@ -242,11 +542,8 @@ coor miCoordinates::invert(const coor& outc ) const
 
 double miCoordinates::toRad( const coor& c ) const
 {
-  double rad;
-  rad  =   float(c.deg)/ 180 ;
-  rad += ( float(c.cmin)/ (180*6000) );
-  rad *=M_PI;
-  return rad;
+  // totalCmin is exact; convert with a single double multiplication
+  return c.totalCmin() * (M_PI / (180*6000));
 }
 
 
@@ -339,14 +636,17 @@ miCoordinates operator/(miCoordinates lhs,float rhs)
 
 
 
-bool operator==( const miCoordinates& lhs, const miCoordinates& rhs)
+uint64_t miCoordinates::key() const
 {
-  if (lhs.iLon() != rhs.iLon() )
-    return false;
-  if (lhs.iLat() != rhs.iLat() )
-    return false;
+  // flipping the sign bit maps int32 order to uint32 order
+  const uint32_t klon = uint32_t(lon_.totalCmin()) ^ 0x80000000u;
+  const uint32_t klat = uint32_t(lat_.totalCmin()) ^ 0x80000000u;
+  return (uint64_t(klon) << 32) | klat;
+}
 
-  return true;
+bool operator==( const miCoordinates& lhs, const miCoordinates& rhs)
+{
+  return lhs.key() == rhs.key();
 }
 
 bool operator!=( const miCoordinates& lhs, const miCoordinates& rhs)
@@ -356,9 +656,7 @@ bool operator!=( const miCoordinates& lhs, const miCoordinates& rhs)
 
 bool operator>( const miCoordinates& lhs, const miCoordinates& rhs)
 {
-  int a = lhs.iLon()*100 + lhs.iLat();
-  int b = rhs.iLon()*100 + rhs.iLat();
-  return a>b ;
+  return lhs.key() > rhs.key();
 }
 
 bool operator<( const miCoordinates& lhs, const miCoordinates& rhs)
@@ -425,66 +723,153 @@ void miCoordinates::addLat(coor rhs)
 // --- ostream ---
 
 
-std::string miCoordinates::str()
+namespace {
+
+// writes "deg\u00B0 min'H" like ostream output of abs(deg) and fabs(cmin/100.f)
+std::size_t formatCoor(const coor& c, char hemisphere, char* buffer, std::size_t size)
 {
-  std::ostringstream out;
-  out << sLon() << " : " << sLat();
-  return out.str();
+  char tmp[miCoordinates::FORMATTED_MAX_SIZE];
+  char* p = tmp;
+  char* const end = tmp + sizeof(tmp);
+
+  const unsigned int deg = c.deg < 0 ? 0u - unsigned(c.deg) : unsigned(c.deg);
+  p = std::to_chars(p, end, deg).ptr;
+  *p++ = '\xC2'; // utf-8 degree-sign
+  *p++ = '\xB0';
+  *p++ = ' ';
+
+  const unsigned int cmin = c.cmin < 0 ? 0u - unsigned(c.cmin) : unsigned(c.cmin);
+  p = std::to_chars(p, end, cmin / 100).ptr;
+  const unsigned int frac = cmin % 100;
+  if (frac != 0) {
+    *p++ = '.';
+    *p++ = char('0' + frac / 10);
+    if (frac % 10 != 0)
+      *p++ = char('0' + frac % 10);
+  }
+  *p++ = '\'';
+  *p++ = hemisphere;
+
+  const std::size_t length = p - tmp;
+  if (length > size)
+    return 0;
+  std::copy(tmp, p, buffer);
+  return length;
 }
 
-std::string miCoordinates::encode()
+} // namespace
+
+std::size_t miCoordinates::sLon(char* buffer, std::size_t size) const
 {
-  std::ostringstream out;
-  out << lon_.deg << ":" << lon_.cmin << ":"
-      << lat_.deg << ":" << lat_.cmin;
-  return out.str();
+  return formatCoor(lon_, (iLon() < 0) ? 'W' : 'E', buffer, size);
 }
 
-bool miCoordinates::decode(const std::string& token)
+std::size_t miCoordinates::sLat(char* buffer, std::size_t size) const
 {
-  std::vector<std::string> words;
-  boost::split(words, token, boost::algorithm::is_any_of(":"));
+  return formatCoor(lat_, (iLat() < 0) ? 'S' : 'N', buffer, size);
+}
 
-  if (words.size() != 4)
-    return false;
+std::size_t miCoordinates::str(char* buffer, std::size_t size) const
+{
+  const std::size_t nlon = sLon(buffer, size);
+  if (nlon == 0 || size - nlon < 3)
+    return 0;
+  std::copy(" : ", " : " + 3, buffer + nlon);
+  const std::size_t nlat = sLat(buffer + nlon + 3, size - nlon - 3);
+  if (nlat == 0)
+    return 0;
+  return nlon + 3 + nlat;
+}
 
-  try {
-    lon_.deg = boost::lexical_cast<int>(words[0]);
-    lon_.cmin= boost::lexical_cast<int>(words[1]);
-    lat_.deg = boost::lexical_cast<int>(words[2]);
-    lat_.cmin= boost::lexical_cast<int>(words[3]);
-  } catch ( std::exception& e) {
-    return false;
+std::string miCoordinates::str() const
+{
+  char buffer[STR_MAX_SIZE];
+  return std::string(buffer, str(buffer, sizeof(buffer)));
+}
+
+std::string miCoordinates::encode() const
+{
+  char buffer[ENCODED_MAX_SIZE];
+  return std::string(buffer, encode(buffer, sizeof(buffer)));
+}
+
+std::size_t miCoordinates::encode(char* buffer, std::size_t size) const
+{
+  const int values[4] = { lon_.deg, lon_.cmin, lat_.deg, lat_.cmin };
+  char* p = buffer;
+  char* const end = buffer + size;
+  for (int i = 0; i < 4; ++i) {
+    if (i > 0) {
+      if (p == end)
+        return 0;
+      *p++ = ':';
+    }
+    const std::to_chars_result r = std::to_chars(p, end, values[i]);
+    if (r.ec != std::errc())
+      return 0;
+    p = r.ptr;
   }
+  return p - buffer;
+}
+
+bool miCoordinates::decode(std::string_view token)
+{
+  int values[4];
+  for (int i = 0; i < 4; ++i) {
+    const std::size_t colon = (i < 3) ? token.find(':') : std::string_view::npos;
+    if (i < 3 && colon == std::string_view::npos)
+      return false;
+    if (!miParse::number(token.substr(0, colon), values[i]))
+      return false;
+    if (i < 3)
+      token.remove_prefix(colon + 1);
+  }
+
+  lon_.deg = values[0];
+  lon_.cmin= values[1];
+  lat_.deg = values[2];
+  lat_.cmin= values[3];
   return true;
+}
+
+std::size_t miCoordinates::decodeLines(std::string_view text, std::vector<miCoordinates>& coordinates)
+{
+  std::size_t bad = 0;
+  miCoordinates c;
+  while (!text.empty()) {
+    const std::size_t eol = text.find('\n');
+    std::string_view line = text.substr(0, eol);
+    text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
 
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+    if (line.empty())
+      continue;
+    if (c.decode(line))
+      coordinates.push_back(c);
+    else
+      bad += 1;
+  }
+  return bad;
 }
 
-std::string miCoordinates::sLon()
+std::string miCoordinates::sLon() const
 {
- std::ostringstream out;
- char lonp = ((iLon() < 0) ? 'W': 'E');
- out << abs(lon_.deg) << "\u00B0 " // utf-8 degree-sign
-     << fabs(float(lon_.cmin)/100)
-     << "\'" << lonp;
- return out.str();
+  char buffer[FORMATTED_MAX_SIZE];
+  return std::string(buffer, sLon(buffer, sizeof(buffer)));
 }
 
 
-std::string miCoordinates::sLat()
+std::string miCoordinates::sLat() const
 {
- std::ostringstream out;
- char latp = ((iLat() < 0) ? 'S': 'N');
- out << abs(lat_.deg) << "\u00B0 " // utf-8 degree-sign
-     << fabs(float(lat_.cmin)/100)
-     << "\'" << latp;
- return out.str();
+  char buffer[FORMATTED_MAX_SIZE];
+  return std::string(buffer, sLat(buffer, sizeof(buffer)));
 }
 
 std::ostream& operator<<(std::ostream& out, const miCoordinates& rhs)
 {
-  miCoordinates tmp = rhs;
-  out << tmp.str();
+  char buffer[miCoordinates::STR_MAX_SIZE];
+  out.write(buffer, rhs.str(buffer, sizeof(buffer)));
   return out;
 }
 
@@ -501,13 +886,13 @@ double miCoordinates::sekant(double ang) const
 // --- distance to somewhere (in m)
 double miCoordinates::distanceTo(const miCoordinates& to) const
 {
-  return LonLat(rLon(), rLat()).distanceTo(LonLat(to.rLon(), to.rLat()));
+  return lonLat().distanceTo(to.lonLat());
 }
 
 /*! initial bearing to a lon/lat point in radians */
 double miCoordinates::bearingToR(const miCoordinates& to) const
 {
-  return LonLat(rLon(), rLat()).bearingTo(LonLat(to.rLon(), to.rLat()));
+  return lonLat().bearingTo(to.lonLat());
 }
 
 double miCoordinates::bearingToD(const miCoordinates& to) const
@@ -526,6 +911,30 @@ bool miCoordinates::isCloserThan(const miCoordinates& lhs, int tolerance)
 {
   if(tolerance==0)
     return ( lhs == *this );
+  if(tolerance<0)
+    return false;
+
+  // distance() truncates to km, so distance(lhs) <= tolerance is the same
+  // as a distance below tolerance+1 km; compare the haversine term, which
+  // is a quarter of the squared chord, instead of calculating the distance
+  const double lat1 = rLat(), lat2 = lhs.rLat();
+  const double sinlat = std::sin((lat2 - lat1) / 2);
+  const double sinlon = std::sin((lhs.rLon() - rLon()) / 2);
+  const double a = sinlat * sinlat + std::cos(lat1) * std::cos(lat2) * sinlon * sinlon;
+  return ( 4*a < chord2ForDistance((tolerance + 1) * 1000.0) );
+}
+
+/*
+  ===================================================
+                 miPreparedCoordinates
+  ===================================================
+*/
 
-  return ( distance(lhs) <= tolerance );
+bool miPreparedCoordinates::isCloserThan(const miPreparedCoordinates& lhs, int tolerance) const
+{
+  if(tolerance==0)
+    return ( lhs.mCoordinates == mCoordinates );
+  if(tolerance<0)
+    return false;
+  return ( mPrepared.chord2To(lhs.mPrepared) < chord2ForDistance((tolerance + 1) * 1000.0) );
 }
@@ -31,12 +31,54 @@
 #ifndef puDatatypes_miCoordinates_h
 #define puDatatypes_miCoordinates_h
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /*! mean earth radius in m */
 extern const double EARTH_RADIUS_M;
 
+/*! Methods for calculating distances between LonLat points.
+ *
+ *  Maximum relative errors compared to DISTANCE_HAVERSINE for points
+ *  up to 100 km apart, by latitude band of the points:
+ *
+ *  mode                      0-30   30-60   60-80   80-90
+ *  DISTANCE_EQUIRECTANGULAR  1e-5   5e-5    5e-4    0 (haversine)
+ *  DISTANCE_CHORD            2e-5   2e-5    2e-5    2e-5
+ *  DISTANCE_POLYNOMIAL       1e-11  1e-11   1e-11   1e-11
+ *
+ *  The plane projection has no useful bound near the poles, so
+ *  DISTANCE_EQUIRECTANGULAR uses the haversine formula if a point is
+ *  beyond 80 degrees latitude.
+ *
+ *  DISTANCE_CHORD is slightly too short, but it is monotone in the
+ *  great circle distance and therefore exact for ranking. Its relative
+ *  error grows as (distance/EARTH_RADIUS_M)^2/24 for longer distances.
+ *  It needs the same sin/cos as the haversine formula but no atan2;
+ *  without any sin/cos per point, use PreparedLonLat::chord2To.
+ *  DISTANCE_POLYNOMIAL stays below 2e-8 for all distances.
+ */
+enum DistanceMode {
+  DISTANCE_HAVERSINE,       //!< haversine formula, as LonLat::distanceTo
+  DISTANCE_EQUIRECTANGULAR, //!< plane projection at the mean latitude, for short distances
+  DISTANCE_CHORD,           //!< straight line through the earth
+  DISTANCE_POLYNOMIAL       //!< haversine formula with polynomial sin/cos/asin
+};
+
+/*! squared chord length on the unit sphere for a great circle distance in m
+ *
+ *  Compare with PreparedLonLat::chord2To to check a distance threshold
+ *  without any trigonometry per point.
+ */
+double chord2ForDistance(double distance);
+
+//! great circle distance in m for a squared chord length on the unit sphere
+double distanceForChord2(double chord2);
+
 class LonLat {
 public:
   LonLat()
@@ -63,6 +105,9 @@ public:
   //! distance along great circle in m
   double distanceTo(const LonLat& to) const;
 
+  //! distance in m, calculated according to 'mode'
+  double distanceTo(const LonLat& to, DistanceMode mode) const;
+
   //! initial bearing along great circle in radians
   double bearingTo(const LonLat& to) const;
 
@@ -73,11 +118,126 @@ public:
   LonLat stepTo(double distance, const LonLat& there) const
     { return stepDirection(distance, bearingTo(there)); }
 
+  /*! distances along great circle in m to 'count' points given as
+   *  separate longitude and latitude arrays (in radians)
+   *
+   *  The trigonometry of this point is computed once and the loop
+   *  has no dependencies between iterations. The results agree with
+   *  distanceTo to within 1e-3 m.
+   */
+  void distancesTo(const double* lons, const double* lats, std::size_t count, double* distances) const;
+
 private:
   double mLon;
   double mLat;
 };
 
+/*! LonLat with cached sin/cos of latitude and longitude.
+ *
+ *  Meant for querying one point against many others. Queries against
+ *  another PreparedLonLat need no sin/cos at all.
+ */
+class PreparedLonLat {
+public:
+  PreparedLonLat()
+    : mSinLat(0), mCosLat(1), mSinLon(0), mCosLon(1) { }
+  explicit PreparedLonLat(const LonLat& ll);
+
+  const LonLat& lonLat() const
+    { return mLonLat; }
+
+  //! longitude in radians
+  double lon() const
+    { return mLonLat.lon(); }
+
+  //! latitude in radians
+  double lat() const
+    { return mLonLat.lat(); }
+
+  double sinLat() const
+    { return mSinLat; }
+  double cosLat() const
+    { return mCosLat; }
+
+  //! distance along great circle in m
+  double distanceTo(const LonLat& to) const;
+  double distanceTo(const PreparedLonLat& to) const;
+
+  //! squared chord length on the unit sphere, see chord2ForDistance
+  double chord2To(const PreparedLonLat& to) const;
+
+  //! position as unit vector, with z towards the north pole and x towards longitude 0
+  void unitVector(double xyz[3]) const;
+
+  //! initial bearing along great circle in radians
+  double bearingTo(const LonLat& to) const;
+  double bearingTo(const PreparedLonLat& to) const;
+
+  //! distance along great circle in m and initial bearing in radians
+  void distanceAndBearingTo(const LonLat& to, double& distance, double& bearing) const;
+  void distanceAndBearingTo(const PreparedLonLat& to, double& distance, double& bearing) const;
+
+  //! calculate final point going 'distance' meters from here in direction 'bearing' (in radians)
+  LonLat stepDirection(double distance, double bearing) const;
+
+private:
+  LonLat mLonLat;
+  double mSinLat;
+  double mCosLat;
+  double mSinLon;
+  double mCosLon;
+};
+
+/*! Great circle through a start point, for generating many points along it.
+ *
+ *  The setup is done once; each generated point costs one sqrt and two
+ *  atan2. Longitudes are returned as start longitude plus an offset in
+ *  [-pi, pi], like LonLat::stepDirection.
+ */
+class GreatCircle {
+public:
+  //! great circle from 'from' to 'to'
+  GreatCircle(const LonLat& from, const LonLat& to);
+
+  //! great circle starting at 'from' in direction 'bearing' (in radians); length() is 0
+  static GreatCircle fromBearing(const LonLat& from, double bearing);
+
+  //! distance from start to end along great circle in m
+  double length() const
+    { return mAngle * EARTH_RADIUS_M; }
+
+  //! point 'distance' meters from the start
+  LonLat pointAt(double distance) const;
+
+  //! number of points needed by interpolate to have at most 'spacing' meters between neighbours
+  std::size_t countForSpacing(double spacing) const;
+
+  //! fill 'count' evenly spaced points from start to end (both included) into 'points'
+  void interpolate(std::size_t count, LonLat* points) const;
+
+  //! fill 'count' points starting at the start point, 'spacing' meters apart, into 'points'
+  void stepEvery(double spacing, std::size_t count, LonLat* points) const;
+
+  //! fill the points 'distances[i]' meters from the start into 'points'
+  void stepDirections(const double* distances, std::size_t count, LonLat* points) const;
+
+private:
+  GreatCircle(const LonLat& from, double bearing, double angle);
+
+  LonLat pointAtAngle(double cos_a, double sin_a) const;
+  void stepAngles(double angle0, double dangle, std::size_t count, LonLat* points) const;
+
+  LonLat mFrom;
+  double mSinLat;
+  double mCosLat;
+  // direction of travel at the start, as unit vector with start at longitude 0
+  double mDirX;
+  double mDirY;
+  double mDirZ;
+  // angular length in radians
+  double mAngle;
+};
+
 // class to hold station coordinates
 // the usual format (taken from the klima database is
 // degrees, minutes and centiminutes ( if wanted ).
@@ -95,6 +255,8 @@ struct coor {
   void addCmin(const int& );
   float fCoor() const
   { return ( (float(cmin)/6000.0) + float(deg) ); }
+  int totalCmin() const // exact, used for comparisons
+  { return deg*6000 + cmin; }
 
   friend bool operator==(const coor& lhs, const coor& rhs);
   friend bool operator!=(const coor& lhs, const coor& rhs);
@@ -147,17 +309,39 @@ public:
   coor  Lon()  const  { return lon_;        }
   double rLon() const { return toRad(lon_); }
   double rLat() const { return toRad(lat_); }
-
-  std::string sLon();  // example: "11 05' W"
-  std::string sLat();  // example: "59 19' N"
-  std::string str();   // sLon()" : "sLat()
-  std::string encode();// "lon_deg:lon_min:lat_deg:lat_min"
-  bool decode(const std::string&);// decodes encode-string
+  LonLat lonLat() const { return LonLat(rLon(), rLat()); }
+
+  std::string sLon() const;  // example: "11° 5'W"
+  std::string sLat() const;  // example: "59° 19.5'N"
+  std::string str() const;   // sLon()" : "sLat()
+
+  // longest possible sLon/sLat and str strings (utf-8)
+  static constexpr std::size_t FORMATTED_MAX_SIZE = 11 + 3 + 11 + 2;
+  static constexpr std::size_t STR_MAX_SIZE = 2*FORMATTED_MAX_SIZE + 3;
+  // write sLon/sLat/str to buffer, without terminating 0;
+  // return the length, or 0 if size is too small
+  std::size_t sLon(char* buffer, std::size_t size) const;
+  std::size_t sLat(char* buffer, std::size_t size) const;
+  std::size_t str(char* buffer, std::size_t size) const;
+  std::string encode() const;// "lon_deg:lon_min:lat_deg:lat_min"
+  bool decode(std::string_view);// decodes encode-string
+
+  // longest possible encode-string
+  static constexpr std::size_t ENCODED_MAX_SIZE = 4*11 + 3;
+  // writes the encode-string to buffer, without terminating 0;
+  // returns the length, or 0 if size is too small
+  std::size_t encode(char* buffer, std::size_t size) const;
+  // decodes newline-separated encode-strings and appends them to
+  // coordinates, skipping empty lines; returns the number of bad lines
+  static std::size_t decodeLines(std::string_view text, std::vector<miCoordinates>& coordinates);
 
   friend miCoordinates operator+(const miCoordinates&, const miCoordinates&);
   friend miCoordinates operator-(const miCoordinates&, const miCoordinates&);
   friend miCoordinates operator/(miCoordinates,float);
 
+  // key() is ordered by longitude and then latitude, and exact
+  uint64_t key() const;
+
   friend bool operator>(const miCoordinates&,const miCoordinates&);
   friend bool operator<(const miCoordinates&,const miCoordinates&);
 
@@ -180,4 +364,58 @@ public:
   bool isCloserThan(const miCoordinates&, int tolerance);// distance in km's
 };
 
+/*! miCoordinates with radians and sin/cos of latitude and longitude
+ *  computed once at construction.
+ *
+ *  Meant for stations or other fixed points that take part in many
+ *  distance or bearing calculations; the results match the
+ *  miCoordinates functions of the same name.
+ */
+class miPreparedCoordinates {
+public:
+  miPreparedCoordinates() { }
+  miPreparedCoordinates(const miCoordinates& c)
+    : mCoordinates(c), mPrepared(c.lonLat()) { }
+
+  const miCoordinates& coordinates() const
+    { return mCoordinates; }
+  const PreparedLonLat& prepared() const
+    { return mPrepared; }
+  const LonLat& lonLat() const
+    { return mPrepared.lonLat(); }
+
+  double rLon() const { return mPrepared.lon(); }
+  double rLat() const { return mPrepared.lat(); }
+
+  int distance(const miPreparedCoordinates& c) const // distance in km's
+    { return static_cast<int>(distanceTo(c)/1000); }
+  double distanceTo(const miPreparedCoordinates& c) const // distance in m's
+    { return mPrepared.distanceTo(c.mPrepared); }
+  double distanceTo(const miCoordinates& c) const // distance in m's
+    { return mPrepared.distanceTo(c.lonLat()); }
+
+  double bearingToR(const miPreparedCoordinates& to) const // initial bearing in radians
+    { return mPrepared.bearingTo(to.mPrepared); }
+
+  bool isCloserThan(const miPreparedCoordinates&, int tolerance) const;// distance in km's
+
+private:
+  miCoordinates mCoordinates;
+  PreparedLonLat mPrepared;
+};
+
+namespace std {
+template<>
+struct hash<miCoordinates> {
+  size_t operator()(const miCoordinates& c) const
+    {
+      // splitmix64 finalizer
+      uint64_t k = c.key();
+      k = (k ^ (k >> 30)) * 0xbf58476d1ce4e5b9ull;
+      k = (k ^ (k >> 27)) * 0x94d049bb133111ebull;
+      return size_t(k ^ (k >> 31));
+    }
+};
+} // namespace std
+
 #endif // puDatatypes_miCoordinates_h
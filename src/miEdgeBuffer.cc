@@ -0,0 +1,186 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miEdgeBuffer.h"
+
+#include "miRegions.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const std::size_t BLOCK = 64;
+
+// number of set bits
+int popCount(uint64_t v)
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll(v);
+#else
+  int n = 0;
+  for (; v; v &= v - 1)
+    n += 1;
+  return n;
+#endif
+}
+
+#if defined(__SSE2__)
+// loads two floats and widens them to double
+inline __m128d loadPair(const float* p)
+{
+  return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+}
+#endif
+
+} // namespace
+
+miEdgeBuffer::miEdgeBuffer(const std::vector<miLine>& edges)
+{
+  set(edges);
+}
+
+miEdgeBuffer::miEdgeBuffer(const miRegions& region)
+{
+  set(region.getBorders());
+}
+
+void miEdgeBuffer::set(const std::vector<miLine>& edges)
+{
+  mEdges = edges;
+  const std::size_t n = edges.size();
+  mX1.resize(n);
+  mY1.resize(n);
+  mX2.resize(n);
+  mY2.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+    edges[i].endpoints(mX1[i], mY1[i], mX2[i], mY2[i]);
+}
+
+uint64_t miEdgeBuffer::crossed(const miLine& target, std::size_t begin, std::size_t end) const
+{
+  float fx1, fy1, fx2, fy2;
+  target.endpoints(fx1, fy1, fx2, fy2);
+  const double qx1 = fx1, qy1 = fy1, qx2 = fx2, qy2 = fy2;
+  const double qdx = qx2 - qx1, qdy = qy2 - qy1;
+  const double qxmin = std::min(qx1, qx2), qxmax = std::max(qx1, qx2);
+  const double qymin = std::min(qy1, qy2), qymax = std::max(qy1, qy2);
+
+  const float* x1 = mX1.data();
+  const float* y1 = mY1.data();
+  const float* x2 = mX2.data();
+  const float* y2 = mY2.data();
+  uint64_t bits = 0;
+  std::size_t i = begin;
+
+#if defined(__SSE2__)
+  // the same operations as the loop below, on two edges at a time
+  const __m128d vqx1 = _mm_set1_pd(qx1), vqy1 = _mm_set1_pd(qy1);
+  const __m128d vqx2 = _mm_set1_pd(qx2), vqy2 = _mm_set1_pd(qy2);
+  const __m128d vqdx = _mm_set1_pd(qdx), vqdy = _mm_set1_pd(qdy);
+  const __m128d vqxmin = _mm_set1_pd(qxmin), vqxmax = _mm_set1_pd(qxmax);
+  const __m128d vqymin = _mm_set1_pd(qymin), vqymax = _mm_set1_pd(qymax);
+  const __m128d zero = _mm_setzero_pd(), sign = _mm_set1_pd(-0.0);
+  for (; i + 2 <= end; i += 2) {
+    const __m128d ex1 = loadPair(x1 + i);
+    const __m128d ey1 = loadPair(y1 + i);
+    const __m128d ex2 = loadPair(x2 + i);
+    const __m128d ey2 = loadPair(y2 + i);
+
+    const __m128d d1 = _mm_sub_pd(_mm_mul_pd(vqdx, _mm_sub_pd(ey1, vqy1)), _mm_mul_pd(vqdy, _mm_sub_pd(ex1, vqx1)));
+    const __m128d d2 = _mm_sub_pd(_mm_mul_pd(vqdx, _mm_sub_pd(ey2, vqy1)), _mm_mul_pd(vqdy, _mm_sub_pd(ex2, vqx1)));
+    const __m128d edx = _mm_sub_pd(ex2, ex1), edy = _mm_sub_pd(ey2, ey1);
+    const __m128d d3 = _mm_sub_pd(_mm_mul_pd(edx, _mm_sub_pd(vqy1, ey1)), _mm_mul_pd(edy, _mm_sub_pd(vqx1, ex1)));
+    const __m128d d4 = _mm_sub_pd(_mm_mul_pd(edx, _mm_sub_pd(vqy2, ey1)), _mm_mul_pd(edy, _mm_sub_pd(vqx2, ex1)));
+
+    const __m128d straddle = _mm_max_pd(_mm_mul_pd(d1, d2), _mm_mul_pd(d3, d4));
+    const __m128d gap = _mm_max_pd(
+        _mm_max_pd(_mm_sub_pd(vqxmin, _mm_max_pd(ex1, ex2)), _mm_sub_pd(_mm_min_pd(ex1, ex2), vqxmax)),
+        _mm_max_pd(_mm_sub_pd(vqymin, _mm_max_pd(ey1, ey2)), _mm_sub_pd(_mm_min_pd(ey1, ey2), vqymax)));
+    const __m128d collinear = _mm_add_pd(_mm_andnot_pd(sign, d1), _mm_andnot_pd(sign, d2));
+    const __m128d isCollinear = _mm_cmpeq_pd(collinear, zero);
+    const __m128d key = _mm_or_pd(_mm_and_pd(isCollinear, gap), _mm_andnot_pd(isCollinear, straddle));
+    bits |= uint64_t(_mm_movemask_pd(_mm_cmple_pd(key, zero))) << (i - begin);
+  }
+#endif
+
+  for (; i < end; ++i) {
+    const double ex1 = x1[i], ey1 = y1[i], ex2 = x2[i], ey2 = y2[i];
+    // sides of the edge end points relative to the target, and vice versa
+    const double d1 = qdx*(ey1 - qy1) - qdy*(ex1 - qx1);
+    const double d2 = qdx*(ey2 - qy1) - qdy*(ex2 - qx1);
+    const double edx = ex2 - ex1, edy = ey2 - ey1;
+    const double d3 = edx*(qy1 - ey1) - edy*(qx1 - ex1);
+    const double d4 = edx*(qy2 - ey1) - edy*(qx2 - ex1);
+
+    // the segments straddle each other if both products are <= 0;
+    // collinear segments cross only if their bounding boxes overlap
+    const double straddle = std::max(d1*d2, d3*d4);
+    const double gap = std::max(
+        std::max(qxmin - std::max(ex1, ex2), std::min(ex1, ex2) - qxmax),
+        std::max(qymin - std::max(ey1, ey2), std::min(ey1, ey2) - qymax));
+    const double collinear = std::fabs(d1) + std::fabs(d2);
+    const double key = (collinear == 0) ? gap : straddle;
+    bits |= uint64_t(key <= 0) << (i - begin);
+  }
+  return bits;
+}
+
+int miEdgeBuffer::countCrossings(const miLine& target, CrossMode mode) const
+{
+  int count = 0;
+  if (mode == CROSS_REFERENCE) {
+    for (std::size_t i = 0; i < mEdges.size(); ++i)
+      count += mEdges[i].cross(target);
+    return count;
+  }
+
+  for (std::size_t b = 0; b < size(); b += BLOCK)
+    count += popCount(crossed(target, b, std::min(size(), b + BLOCK)));
+  return count;
+}
+
+void miEdgeBuffer::crossings(const miLine& target, std::vector<uint64_t>& mask, CrossMode mode) const
+{
+  mask.assign((size() + 63) / 64, 0);
+  for (std::size_t b = 0; b < size(); b += BLOCK) {
+    const std::size_t e = std::min(size(), b + BLOCK);
+    if (mode == CROSS_REFERENCE) {
+      uint64_t bits = 0;
+      for (std::size_t i = b; i < e; ++i)
+        bits |= uint64_t(mEdges[i].cross(target)) << (i - b);
+      mask[b / 64] = bits;
+    } else {
+      mask[b / 64] = crossed(target, b, e);
+    }
+  }
+}
@@ -0,0 +1,83 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miEdgeBuffer_h
+#define puDatatypes_miEdgeBuffer_h
+
+#include "miLine.h"
+
+#include <cstdint>
+#include <vector>
+
+class miRegions;
+
+/*! Edges of a polygon border stored as arrays of end point coordinates,
+ *  for testing one segment against all edges at once.
+ *
+ *  CROSS_ORIENTATION decides crossings with orientation tests, without
+ *  branches or divisions. On x86 the tests run on two edges at a time
+ *  with SSE2 intrinsics, which does not depend on the optimization level;
+ *  other targets use the same tests in a plain loop. The coordinates are
+ *  stored as float, like in miLine, and the tests are done in double, so
+ *  both give the same results. Segments that touch or overlap count as
+ *  crossing.
+ *
+ *  CROSS_REFERENCE calls miLine::cross for each edge and gives exactly
+ *  its results, including the 0.0001 degree tolerance and the special
+ *  cases for horizontal and vertical lines.
+ */
+class miEdgeBuffer {
+public:
+  enum CrossMode { CROSS_ORIENTATION, CROSS_REFERENCE };
+
+  miEdgeBuffer() { }
+  explicit miEdgeBuffer(const std::vector<miLine>& edges);
+  explicit miEdgeBuffer(const miRegions& region);
+
+  void set(const std::vector<miLine>& edges);
+
+  std::size_t size() const
+    { return mEdges.size(); }
+
+  //! number of edges crossed by 'target'
+  int countCrossings(const miLine& target, CrossMode mode = CROSS_ORIENTATION) const;
+
+  //! bit i%64 of mask[i/64] is set if edge i is crossed by 'target'
+  void crossings(const miLine& target, std::vector<uint64_t>& mask,
+      CrossMode mode = CROSS_ORIENTATION) const;
+
+private:
+  // bit i - begin is set if edge i in [begin, end) is crossed, for end - begin <= 64
+  uint64_t crossed(const miLine& target, std::size_t begin, std::size_t end) const;
+
+private:
+  std::vector<miLine> mEdges;
+  std::vector<float> mX1, mY1, mX2, mY2;
+};
+
+#endif // puDatatypes_miEdgeBuffer_h
@@ -0,0 +1,771 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miGeodesic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+extern const double WGS84_A = 6378137.0;
+extern const double WGS84_F = 1/298.257223563;
+
+/*
+  The algorithms and series coefficients follow C. F. F. Karney,
+  "Algorithms for geodesics", J. Geodesy 87 (2013) 43-55, and his
+  GeographicLib (MIT license). Angles are handled in degrees internally,
+  so that quadrant boundaries such as the poles and the antimeridian are
+  exact.
+*/
+
+namespace {
+
+const double DEG = M_PI / 180;
+
+const int MAXIT1 = 20;
+const int MAXIT2 = MAXIT1 + std::numeric_limits<double>::digits + 10;
+const double TINY = std::sqrt(std::numeric_limits<double>::min());
+const double TOL0 = std::numeric_limits<double>::epsilon();
+const double TOL1 = 200 * TOL0;
+const double TOL2 = std::sqrt(TOL0);
+const double TOLB = TOL0;
+const double XTHRESH = 1000 * TOL2;
+
+inline double sq(double x)
+{
+  return x*x;
+}
+
+// s and c are not large enough for std::hypot to be needed
+void norm(double& s, double& c)
+{
+  const double r = std::sqrt(s*s + c*c);
+  s /= r;
+  c /= r;
+}
+
+// p[0]*x^N + ... + p[N]
+double polyval(int N, const double* p, double x)
+{
+  double y = (N < 0) ? 0 : *p;
+  while (N-- > 0)
+    y = y*x + *++p;
+  return y;
+}
+
+// rounds small angles so that they underflow to 0 instead of becoming tiny
+double angRound(double x)
+{
+  const double z = 1/16.0;
+  volatile double y = std::fabs(x);
+  if (y < z)
+    y = z - (z - y);
+  return std::copysign(y, x);
+}
+
+// y - x in degrees, in [-180, 180], with its rounding error in 'e';
+// u and v must be remainder(-x, 360) and remainder(y, 360)
+double angDiff(double x, double y, double u, double v, double& e)
+{
+  // error-free sums, see Knuth TAOCP vol. 2, 4.2.2
+  volatile double s = u + v;
+  double up = s - v, vpp = s - up;
+  up -= u;
+  vpp -= v;
+  const double t = (s == 0) ? 0 : -(up + vpp);
+
+  const double d = std::remainder(s, 360.0);
+  volatile double s2 = d + t;
+  up = s2 - t;
+  vpp = s2 - up;
+  up -= d;
+  vpp -= t;
+  e = (s2 == 0) ? 0 : -(up + vpp);
+  if (s2 == 0 || std::fabs(s2) == 180)
+    return std::copysign(s2, e == 0 ? y - x : -e);
+  return s2;
+}
+
+// sin and cos of x + t degrees, exact at multiples of 90 degrees
+void sincosd(double x, double t, double& s, double& c)
+{
+  double r = std::fmod(x, 360.0);
+  const int q = std::isnan(r) ? 0 : int(std::lround(r / 90));
+  r = angRound((r - 90*q) + t) * DEG;
+  const double sr = std::sin(r), cr = std::cos(r);
+  switch (unsigned(q) & 3u) {
+  case 0u: s =  sr; c =  cr; break;
+  case 1u: s =  cr; c = -sr; break;
+  case 2u: s = -sr; c = -cr; break;
+  default: s = -cr; c =  sr; break;
+  }
+  c += 0;
+  if (s == 0)
+    s = std::copysign(s, x);
+}
+
+// sum of c[i] sin(2 i x) for i = 1..n, by Clenshaw summation
+double sinSeries(double sinx, double cosx, const double* c, int n)
+{
+  const double ar = 2 * (cosx - sinx) * (cosx + sinx); // 2 cos(2x)
+  double y0 = (n & 1) ? c[n] : 0, y1 = 0;
+  int k = (n & 1) ? n : n + 1;
+  for (n /= 2; n > 0; --n) {
+    y1 = ar*y0 - y1 + c[--k];
+    y0 = ar*y1 - y0 + c[--k];
+  }
+  return 2 * sinx * cosx * y0;
+}
+
+// the series for the distance, see Karney (2013), eqs. (17) and (18)
+double A1m1f(double eps)
+{
+  const double e2 = sq(eps);
+  const double t = e2 * ((e2 + 4)*e2 + 64) * (1/256.0);
+  return (t + eps) / (1 - eps);
+}
+
+void C1f(double eps, double c[7])
+{
+  const double e2 = sq(eps), e3 = e2*eps, e4 = e2*e2;
+  c[1] = eps * ((6 - e2)*e2 - 16) * (1/32.0);
+  c[2] = e2 * ((64 - 9*e2)*e2 - 128) * (1/2048.0);
+  c[3] = e3 * (9*e2 - 16) * (1/768.0);
+  c[4] = e4 * (3*e2 - 5) * (1/512.0);
+  c[5] = e4*eps * (-7/1280.0);
+  c[6] = e4*e2 * (-7/2048.0);
+}
+
+// the reverted series, eq. (21)
+void C1pf(double eps, double c[7])
+{
+  const double e2 = sq(eps), e3 = e2*eps, e4 = e2*e2;
+  c[1] = eps * ((205*e2 - 432)*e2 + 768) * (1/1536.0);
+  c[2] = e2 * ((4005*e2 - 4736)*e2 + 3840) * (1/12288.0);
+  c[3] = e3 * (116 - 225*e2) * (1/384.0);
+  c[4] = e4 * (2695 - 7173*e2) * (1/7680.0);
+  c[5] = e4*eps * (3467/7680.0);
+  c[6] = e4*e2 * (38081/61440.0);
+}
+
+// the series for the reduced length, eqs. (41) and (43)
+double A2m1f(double eps)
+{
+  const double e2 = sq(eps);
+  const double t = e2 * ((-11*e2 - 28)*e2 - 192) * (1/256.0);
+  return (t - eps) / (1 + eps);
+}
+
+void C2f(double eps, double c[7])
+{
+  const double e2 = sq(eps), e3 = e2*eps, e4 = e2*e2;
+  c[1] = eps * ((e2 + 2)*e2 + 16) * (1/32.0);
+  c[2] = e2 * ((35*e2 + 64)*e2 + 384) * (1/2048.0);
+  c[3] = e3 * (15*e2 + 80) * (1/768.0);
+  c[4] = e4 * (7*e2 + 35) * (1/512.0);
+  c[5] = e4*eps * (63/1280.0);
+  c[6] = e4*e2 * (77/2048.0);
+}
+
+// expansion parameter for the azimuth alpha0 at the equator, eq. (16)
+double epsilon(double cosAlpha0, double ep2, double* k2 = 0)
+{
+  const double k = sq(cosAlpha0) * ep2;
+  if (k2)
+    *k2 = k;
+  return k / (2 * (1 + std::sqrt(1 + k)) + k);
+}
+
+// distance s12b = s12/b and reduced length m12b = m12/b, as requested
+void lengths(double eps, double sig12,
+    double ssig1, double csig1, double dn1, double ssig2, double csig2, double dn2,
+    double* s12b, double* m12b, double* m0)
+{
+  double C1a[7], C2a[7];
+  double A1 = A1m1f(eps), A2 = 0, m0x = 0;
+  C1f(eps, C1a);
+  if (m12b) {
+    A2 = A2m1f(eps);
+    C2f(eps, C2a);
+    m0x = A1 - A2;
+    A2 += 1;
+  }
+  A1 += 1;
+
+  double J12 = 0;
+  if (s12b) {
+    const double B1 = sinSeries(ssig2, csig2, C1a, 6) - sinSeries(ssig1, csig1, C1a, 6);
+    *s12b = A1 * (sig12 + B1);
+    if (m12b) {
+      const double B2 = sinSeries(ssig2, csig2, C2a, 6) - sinSeries(ssig1, csig1, C2a, 6);
+      J12 = m0x * sig12 + (A1 * B1 - A2 * B2);
+    }
+  } else if (m12b) {
+    for (int l = 1; l <= 6; ++l)
+      C2a[l] = A1 * C1a[l] - A2 * C2a[l];
+    J12 = m0x * sig12 + (sinSeries(ssig2, csig2, C2a, 6) - sinSeries(ssig1, csig1, C2a, 6));
+  }
+  if (m12b) {
+    if (m0)
+      *m0 = m0x;
+    *m12b = dn2 * (csig1 * ssig2) - dn1 * (ssig1 * csig2) - csig1 * csig2 * J12;
+  }
+}
+
+// positive root k of k^4 + 2k^3 - (x^2 + y^2 - 1) k^2 - 2 y^2 k - y^2 = 0
+double astroid(double x, double y)
+{
+  const double p = sq(x), q = sq(y), r = (p + q - 1) / 6;
+  if (q == 0 && r <= 0)
+    return 0;
+  const double S = p * q / 4, r2 = sq(r), r3 = r * r2;
+  const double disc = S * (S + 2 * r3);
+  double u = r;
+  if (disc >= 0) {
+    double T3 = S + r3;
+    T3 += (T3 < 0) ? -std::sqrt(disc) : std::sqrt(disc);
+    const double T = std::cbrt(T3);
+    u += T + (T != 0 ? r2 / T : 0);
+  } else {
+    const double ang = std::atan2(std::sqrt(-disc), -(S + r3));
+    u += 2 * r * std::cos(ang / 3);
+  }
+  const double v = std::sqrt(sq(u) + q);
+  const double uv = (u < 0) ? q / (v - u) : u + v;
+  const double w = (uv - q) / (2 * v);
+  return uv / (std::sqrt(uv + sq(w)) + w);
+}
+
+// starting azimuth for Newton's method; for short lines also the
+// solution, with sig12 >= 0 returned
+double inverseStart(const miGeodesic& g,
+    double sbet1, double cbet1, double dn1, double sbet2, double cbet2, double dn2,
+    double lam12, double slam12, double clam12,
+    double& salp1, double& calp1, double& salp2, double& calp2, double& dnm)
+{
+  double sig12 = -1;
+  const double sbet12 = sbet2 * cbet1 - cbet2 * sbet1;
+  const double cbet12 = cbet2 * cbet1 + sbet2 * sbet1;
+  volatile double sbet12a = sbet2 * cbet1;
+  sbet12a += cbet2 * sbet1;
+
+  const bool shortline = cbet12 >= 0 && sbet12 < 0.5 && cbet2 * lam12 < 0.5;
+  double somg12, comg12;
+  if (shortline) {
+    double sbetm2 = sq(sbet1 + sbet2);
+    sbetm2 /= sbetm2 + sq(cbet1 + cbet2);
+    dnm = std::sqrt(1 + g.ep2() * sbetm2);
+    const double omg12 = lam12 / ((1 - g.f()) * dnm);
+    somg12 = std::sin(omg12);
+    comg12 = std::cos(omg12);
+  } else {
+    somg12 = slam12;
+    comg12 = clam12;
+  }
+
+  salp1 = cbet2 * somg12;
+  calp1 = (comg12 >= 0)
+      ? sbet12 + cbet2 * sbet1 * sq(somg12) / (1 + comg12)
+      : sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+
+  const double ssig12 = std::sqrt(sq(salp1) + sq(calp1));
+  const double csig12 = sbet1 * sbet2 + cbet1 * cbet2 * comg12;
+
+  // threshold below which the spherical solution with dnm is exact enough
+  const double etol2 = 0.1 * TOL2 / std::sqrt(std::max(0.001, std::fabs(g.f())) * std::min(1.0, 1 - g.f()/2) / 2);
+  if (shortline && ssig12 < etol2) {
+    // really short lines
+    salp2 = cbet1 * somg12;
+    calp2 = sbet12 - cbet1 * sbet2 * (comg12 >= 0 ? sq(somg12) / (1 + comg12) : 1 - comg12);
+    norm(salp2, calp2);
+    sig12 = std::atan2(ssig12, csig12);
+  } else if (std::fabs(g.n()) > 0.1 || csig12 >= 0 || ssig12 >= 6 * std::fabs(g.n()) * M_PI * sq(cbet1)) {
+    // the spherical estimate is good enough
+  } else {
+    // nearly antipodal: scale to coordinates where the antipode is at the
+    // origin and the singular point at (-1, 0), and solve the astroid problem
+    const double lam12x = std::atan2(-slam12, -clam12);
+    double x, y, lamscale, betscale;
+    if (g.f() >= 0) {
+      const double eps = epsilon(sbet1, g.ep2());
+      lamscale = g.f() * cbet1 * g.seriesA3(eps) * M_PI;
+      betscale = lamscale * cbet1;
+      x = lam12x / lamscale;
+      y = sbet12a / betscale;
+    } else {
+      const double cbet12a = cbet2 * cbet1 - sbet2 * sbet1;
+      const double bet12a = std::atan2(sbet12a, cbet12a);
+      double m12b, m0;
+      lengths(g.n(), M_PI + bet12a, sbet1, -cbet1, dn1, sbet2, cbet2, dn2, 0, &m12b, &m0);
+      x = -1 + m12b / (cbet1 * cbet2 * m0 * M_PI);
+      betscale = (x < -0.01) ? sbet12a / x : -g.f() * sq(cbet1) * M_PI;
+      lamscale = betscale / cbet1;
+      y = lam12x / lamscale;
+    }
+
+    if (y > -TOL1 && x > -1 - XTHRESH) {
+      // strip near the cut
+      if (g.f() >= 0) {
+        salp1 = std::min(1.0, -x);
+        calp1 = -std::sqrt(1 - sq(salp1));
+      } else {
+        calp1 = std::max(x > -TOL1 ? 0.0 : -1.0, x);
+        salp1 = std::sqrt(1 - sq(calp1));
+      }
+    } else {
+      const double k = astroid(x, y);
+      const double omg12a = lamscale * (g.f() >= 0 ? -x * k/(1 + k) : -y * (1 + k)/k);
+      somg12 = std::sin(omg12a);
+      comg12 = -std::cos(omg12a);
+      salp1 = cbet2 * somg12;
+      calp1 = sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+    }
+  }
+  // backwards test lets NaN through
+  if (!(salp1 <= 0)) {
+    norm(salp1, calp1);
+  } else {
+    salp1 = 1;
+    calp1 = 0;
+  }
+  return sig12;
+}
+
+// longitude difference reached at beta2 starting with azimuth alpha1,
+// minus the wanted lam12
+struct Lambda12 {
+  double salp2, calp2, sig12, ssig1, csig1, ssig2, csig2, eps;
+};
+
+double lambda12(const miGeodesic& g, double sbet1, double cbet1, double sbet2, double cbet2,
+    double salp1, double calp1, double slam120, double clam120, Lambda12& r)
+{
+  if (sbet1 == 0 && calp1 == 0)
+    calp1 = -TINY; // break the degeneracy of equatorial lines
+
+  const double salp0 = salp1 * cbet1;
+  const double calp0 = std::sqrt(sq(calp1) + sq(salp1 * sbet1));
+
+  r.ssig1 = sbet1;
+  const double somg1 = salp0 * sbet1;
+  r.csig1 = calp1 * cbet1;
+  const double comg1 = r.csig1;
+  norm(r.ssig1, r.csig1);
+
+  // enforce the symmetries for |beta2| = -beta1
+  r.salp2 = (cbet2 != cbet1) ? salp0 / cbet2 : salp1;
+  r.calp2 = (cbet2 != cbet1 || std::fabs(sbet2) != -sbet1)
+      ? std::sqrt(sq(calp1 * cbet1) + (cbet1 < -sbet1 ? (cbet2 - cbet1) * (cbet1 + cbet2)
+              : (sbet1 - sbet2) * (sbet1 + sbet2))) / cbet2
+      : std::fabs(calp1);
+
+  r.ssig2 = sbet2;
+  const double somg2 = salp0 * sbet2;
+  r.csig2 = r.calp2 * cbet2;
+  const double comg2 = r.csig2;
+  norm(r.ssig2, r.csig2);
+
+  r.sig12 = std::atan2(std::max(0.0, r.csig1 * r.ssig2 - r.ssig1 * r.csig2) + 0.0,
+      r.csig1 * r.csig2 + r.ssig1 * r.ssig2);
+
+  const double somg12 = std::max(0.0, comg1 * somg2 - somg1 * comg2) + 0.0;
+  const double comg12 = comg1 * comg2 + somg1 * somg2;
+  const double eta = std::atan2(somg12 * clam120 - comg12 * slam120, comg12 * clam120 + somg12 * slam120);
+
+  r.eps = epsilon(calp0, g.ep2());
+  double C3a[6];
+  g.seriesC3(r.eps, C3a);
+  const double B312 = sinSeries(r.ssig2, r.csig2, C3a, 5) - sinSeries(r.ssig1, r.csig1, C3a, 5);
+  return eta - g.f() * g.seriesA3(r.eps) * salp0 * (r.sig12 + B312);
+}
+
+// derivative of lambda12 with respect to alpha1, eq. (38); computed only
+// when a Newton step is taken
+double dlambda12(const miGeodesic& g, double sbet1, double dn1, double cbet2, double dn2, const Lambda12& r)
+{
+  if (r.calp2 == 0)
+    return -2 * (1 - g.f()) * dn1 / sbet1;
+  double m12b;
+  lengths(r.eps, r.sig12, r.ssig1, r.csig1, dn1, r.ssig2, r.csig2, dn2, 0, &m12b, 0);
+  return m12b * (1 - g.f()) / (r.calp2 * cbet2);
+}
+
+// inverse problem with the azimuths optional, see Karney (2013), section 4
+bool solveInverse(const miGeodesic& g, const miGeodesic::Reduced& from, const miGeodesic::Reduced& to,
+    double& distance, double* azi1, double* azi2)
+{
+  if (std::isnan(from.lon) || std::isnan(from.lat) || std::isnan(to.lon) || std::isnan(to.lat)) {
+    distance = std::numeric_limits<double>::quiet_NaN();
+    if (azi1)
+      *azi1 = distance;
+    if (azi2)
+      *azi2 = distance;
+    return false;
+  }
+
+  // bring the points to the canonical form 0 <= lon12 <= 180,
+  // lat1 <= 0 and lat1 <= lat2 <= -lat1; the signs undo that below
+  double lon12s;
+  double lon12 = angDiff(from.lon, to.lon, -from.lonRemainder, to.lonRemainder, lon12s);
+  double lonsign = std::copysign(1.0, lon12);
+  lon12 *= lonsign;
+  lon12s *= lonsign;
+  const double lam12 = lon12 * DEG;
+  double slam12, clam12;
+  sincosd(lon12, lon12s, slam12, clam12);
+  lon12s = (180 - lon12) - lon12s; // the supplementary longitude difference
+
+  const bool swap = std::fabs(from.lat) < std::fabs(to.lat);
+  const double swapp = swap ? -1 : 1;
+  if (swap)
+    lonsign *= -1;
+  const miGeodesic::Reduced& p1 = swap ? to : from;
+  const miGeodesic::Reduced& p2 = swap ? from : to;
+  const double latsign = std::copysign(1.0, -p1.lat);
+  double sbet1 = latsign * p1.sinBeta, cbet1 = p1.cosBeta, dn1 = p1.dn;
+  double sbet2 = latsign * p2.sinBeta, cbet2 = p2.cosBeta, dn2 = p2.dn;
+
+  // force beta2 = +-beta1 exactly where the difference vanishes
+  if (cbet1 < -sbet1) {
+    if (cbet2 == cbet1)
+      sbet2 = std::copysign(sbet1, sbet2);
+  } else if (std::fabs(sbet2) == -sbet1) {
+    cbet2 = cbet1;
+  }
+
+  double sig12, salp1, calp1, salp2, calp2, s12x = 0;
+  bool meridian = p1.lat * latsign == -90 || slam12 == 0;
+  if (meridian) {
+    // the geodesic may run along the meridian
+    calp1 = clam12;
+    salp1 = slam12;
+    calp2 = 1;
+    salp2 = 0;
+
+    const double ssig1 = sbet1, csig1 = calp1 * cbet1;
+    const double ssig2 = sbet2, csig2 = calp2 * cbet2;
+    sig12 = std::atan2(std::max(0.0, csig1 * ssig2 - ssig1 * csig2) + 0.0, csig1 * csig2 + ssig1 * ssig2);
+
+    double m12x;
+    lengths(g.n(), sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, &s12x, &m12x, 0);
+    if (sig12 < TOL2 || m12x >= 0) {
+      if (sig12 < 3 * TINY || (sig12 < TOL0 && (s12x < 0 || m12x < 0)))
+        s12x = 0;
+      s12x *= g.b();
+    } else {
+      // too close to antipodal on a prolate ellipsoid
+      meridian = false;
+    }
+  }
+
+  if (!meridian && sbet1 == 0 && (g.f() <= 0 || lon12s >= g.f() * 180)) {
+    // along the equator
+    calp1 = calp2 = 0;
+    salp1 = salp2 = 1;
+    s12x = g.a() * lam12;
+  } else if (!meridian) {
+    double dnm = 1;
+    sig12 = inverseStart(g, sbet1, cbet1, dn1, sbet2, cbet2, dn2, lam12, slam12, clam12,
+        salp1, calp1, salp2, calp2, dnm);
+    if (sig12 >= 0) {
+      // short line, solved by inverseStart
+      s12x = sig12 * g.b() * dnm;
+    } else {
+      // Newton's method on lambda12(alpha1) - lam12, keeping a bracket
+      // (alpha1a, alpha1b) around the root and bisecting it where a Newton
+      // step would leave it
+      Lambda12 r;
+      int numit = 0;
+      bool tripn = false, tripb = false;
+      double salp1a = TINY, calp1a = 1, salp1b = TINY, calp1b = -1;
+      for (;; ++numit) {
+        const double v = lambda12(g, sbet1, cbet1, sbet2, cbet2, salp1, calp1, slam12, clam12, r);
+        // reversed test to stop on NaN
+        if (tripb || !(std::fabs(v) >= (tripn ? 8 : 1) * TOL0) || numit == MAXIT2)
+          break;
+        if (v > 0 && (numit > MAXIT1 || calp1/salp1 > calp1b/salp1b)) {
+          salp1b = salp1;
+          calp1b = calp1;
+        } else if (v < 0 && (numit > MAXIT1 || calp1/salp1 < calp1a/salp1a)) {
+          salp1a = salp1;
+          calp1a = calp1;
+        }
+        const double dv = (numit + 1 < MAXIT1) ? dlambda12(g, sbet1, dn1, cbet2, dn2, r) : 0;
+        if (dv > 0) {
+          const double dalp1 = -v/dv;
+          if (std::fabs(dalp1) < M_PI) {
+            const double sdalp1 = std::sin(dalp1), cdalp1 = std::cos(dalp1);
+            const double nsalp1 = salp1 * cdalp1 + calp1 * sdalp1;
+            if (nsalp1 > 0) {
+              calp1 = calp1 * cdalp1 - salp1 * sdalp1;
+              salp1 = nsalp1;
+              norm(salp1, calp1);
+              tripn = std::fabs(v) <= 16 * TOL0;
+              continue;
+            }
+          }
+        }
+        salp1 = (salp1a + salp1b)/2;
+        calp1 = (calp1a + calp1b)/2;
+        norm(salp1, calp1);
+        tripn = false;
+        tripb = (std::fabs(salp1a - salp1) + (calp1a - calp1) < TOLB
+            || std::fabs(salp1 - salp1b) + (calp1 - calp1b) < TOLB);
+      }
+      salp2 = r.salp2;
+      calp2 = r.calp2;
+      lengths(r.eps, r.sig12, r.ssig1, r.csig1, dn1, r.ssig2, r.csig2, dn2, &s12x, 0, 0);
+      s12x *= g.b();
+    }
+  }
+
+  if (swap) {
+    std::swap(salp1, salp2);
+    std::swap(calp1, calp2);
+  }
+  distance = 0.0 + s12x;
+  if (azi1)
+    *azi1 = std::atan2(salp1 * swapp * lonsign, calp1 * swapp * latsign);
+  if (azi2)
+    *azi2 = std::atan2(salp2 * swapp * lonsign, calp2 * swapp * latsign);
+  return true;
+}
+
+} // namespace
+
+/*
+  ===================================================
+                 miGeodesic
+  ===================================================
+*/
+
+miGeodesic::miGeodesic(double a, double f)
+  : mA(a)
+  , mF(f)
+  , mB(a*(1 - f))
+  , mEp2(f*(2 - f) / sq(1 - f))
+  , mN(f / (2 - f))
+{
+  static const double A3coeff[] = {
+    -3, 128,
+    -2, -3, 64,
+    -1, -3, -1, 16,
+    3, -1, -2, 8,
+    1, -1, 2,
+    1, 1,
+  };
+  for (int j = 5, k = 0, o = 0; j >= 0; --j) {
+    const int m = std::min(5 - j, j);
+    mA3x[k++] = polyval(m, A3coeff + o, mN) / A3coeff[o + m + 1];
+    o += m + 2;
+  }
+
+  static const double C3coeff[] = {
+    3, 128,
+    2, 5, 128,
+    -1, 3, 3, 64,
+    -1, 0, 1, 8,
+    -1, 1, 4,
+    5, 256,
+    1, 3, 128,
+    -3, -2, 3, 64,
+    1, -3, 2, 32,
+    7, 512,
+    -10, 9, 384,
+    5, -9, 5, 192,
+    7, 512,
+    -14, 7, 512,
+    21, 2560,
+  };
+  for (int l = 1, k = 0, o = 0; l < 6; ++l) {
+    for (int j = 5; j >= l; --j) {
+      const int m = std::min(5 - j, j);
+      mC3x[k++] = polyval(m, C3coeff + o, mN) / C3coeff[o + m + 1];
+      o += m + 2;
+    }
+  }
+}
+
+double miGeodesic::seriesA3(double eps) const
+{
+  return polyval(5, mA3x, eps);
+}
+
+void miGeodesic::seriesC3(double eps, double c[6]) const
+{
+  double mult = 1;
+  for (int l = 1, o = 0; l < 6; ++l) {
+    const int m = 5 - l;
+    mult *= eps;
+    c[l] = mult * polyval(m, mC3x + o, eps);
+    o += m + 1;
+  }
+}
+
+miGeodesic::Reduced miGeodesic::reduce(const LonLat& p) const
+{
+  Reduced r;
+  r.lon = p.lon() / DEG;
+  r.lonRemainder = std::remainder(r.lon, 360.0);
+  // LonLat::fromDegrees(0, 90) may be a rounding error above 90 degrees
+  r.lat = angRound(std::max(-90.0, std::min(90.0, p.lat() / DEG)));
+  if (std::isnan(p.lat()))
+    r.lat = p.lat();
+  sincosd(r.lat, 0, r.sinBeta, r.cosBeta);
+  r.sinBeta *= 1 - mF;
+  norm(r.sinBeta, r.cosBeta);
+  r.cosBeta = std::max(TINY, r.cosBeta);
+  r.dn = std::sqrt(1 + mEp2 * sq(r.sinBeta));
+  return r;
+}
+
+bool miGeodesic::inverse(const LonLat& from, const LonLat& to, double& distance, double& azi1, double& azi2) const
+{
+  return solveInverse(*this, reduce(from), reduce(to), distance, &azi1, &azi2);
+}
+
+double miGeodesic::distance(const LonLat& from, const LonLat& to) const
+{
+  double distance;
+  solveInverse(*this, reduce(from), reduce(to), distance, 0, 0);
+  return distance;
+}
+
+LonLat miGeodesic::direct(const LonLat& from, double azi1, double distance) const
+{
+  return miGeodesicLine(from, azi1, *this).position(distance);
+}
+
+/*
+  ===================================================
+                 miGeodesicOrigin
+  ===================================================
+*/
+
+miGeodesicOrigin::miGeodesicOrigin(const LonLat& from, const miGeodesic& g)
+  : mGeodesic(g)
+  , mFrom(from)
+  , mReduced(g.reduce(from))
+{
+}
+
+bool miGeodesicOrigin::inverse(const LonLat& to, double& distance, double& azi1, double& azi2) const
+{
+  return solveInverse(mGeodesic, mReduced, mGeodesic.reduce(to), distance, &azi1, &azi2);
+}
+
+double miGeodesicOrigin::distanceTo(const LonLat& to) const
+{
+  double distance;
+  solveInverse(mGeodesic, mReduced, mGeodesic.reduce(to), distance, 0, 0);
+  return distance;
+}
+
+void miGeodesicOrigin::distancesTo(const double* lons, const double* lats, std::size_t count, double* distances) const
+{
+  for (std::size_t i = 0; i < count; ++i)
+    solveInverse(mGeodesic, mReduced, mGeodesic.reduce(LonLat(lons[i], lats[i])), distances[i], 0, 0);
+}
+
+/*
+  ===================================================
+                 miGeodesicLine
+  ===================================================
+*/
+
+miGeodesicLine::miGeodesicLine(const LonLat& from, double azi1, const miGeodesic& g)
+  : mGeodesic(g)
+  , mFrom(from)
+{
+  const miGeodesic::Reduced r = g.reduce(from);
+  double salp1, calp1;
+  sincosd(angRound(azi1 / DEG), 0, salp1, calp1);
+
+  mSinAlpha0 = salp1 * r.cosBeta;
+  mCosAlpha0 = std::hypot(calp1, salp1 * r.sinBeta);
+  mSinSigma1 = r.sinBeta;
+  mSinOmega1 = mSinAlpha0 * r.sinBeta;
+  mCosSigma1 = mCosOmega1 = (r.sinBeta != 0 || calp1 != 0) ? r.cosBeta * calp1 : 1;
+  norm(mSinSigma1, mCosSigma1);
+
+  const double eps = epsilon(mCosAlpha0, g.ep2(), &mK2);
+  mA1m1 = A1m1f(eps);
+  C1f(eps, mC1);
+  mB11 = sinSeries(mSinSigma1, mCosSigma1, mC1, 6);
+  const double s = std::sin(mB11), c = std::cos(mB11);
+  mSinTau1 = mSinSigma1 * c + mCosSigma1 * s;
+  mCosTau1 = mCosSigma1 * c - mSinSigma1 * s;
+  C1pf(eps, mC1p);
+
+  g.seriesC3(eps, mC3);
+  mA3c = -g.f() * mSinAlpha0 * g.seriesA3(eps);
+  mB31 = sinSeries(mSinSigma1, mCosSigma1, mC3, 5);
+}
+
+LonLat miGeodesicLine::position(double distance, double* azi2) const
+{
+  // arc length on the auxiliary sphere from the reverted distance series
+  const double tau12 = distance / (mGeodesic.b() * (1 + mA1m1));
+  const double st = std::sin(tau12), ct = std::cos(tau12);
+  double B12 = -sinSeries(mSinTau1 * ct + mCosTau1 * st, mCosTau1 * ct - mSinTau1 * st, mC1p, 6);
+  double sig12 = tau12 - (B12 - mB11);
+  double ssig12 = std::sin(sig12), csig12 = std::cos(sig12);
+  if (std::fabs(mGeodesic.f()) > 0.01) {
+    // one Newton step for strongly flattened ellipsoids
+    const double ssig2 = mSinSigma1 * csig12 + mCosSigma1 * ssig12;
+    const double csig2 = mCosSigma1 * csig12 - mSinSigma1 * ssig12;
+    B12 = sinSeries(ssig2, csig2, mC1, 6);
+    const double serr = (1 + mA1m1) * (sig12 + (B12 - mB11)) - distance / mGeodesic.b();
+    sig12 -= serr / std::sqrt(1 + mK2 * sq(ssig2));
+    ssig12 = std::sin(sig12);
+    csig12 = std::cos(sig12);
+  }
+
+  double ssig2 = mSinSigma1 * csig12 + mCosSigma1 * ssig12;
+  double csig2 = mCosSigma1 * csig12 - mSinSigma1 * ssig12;
+  const double sbet2 = mCosAlpha0 * ssig2;
+  double cbet2 = std::hypot(mSinAlpha0, mCosAlpha0 * csig2);
+  if (cbet2 == 0)
+    cbet2 = csig2 = TINY;
+
+  // longitude, unrolled so that it grows with the distance
+  const double E = std::copysign(1.0, mSinAlpha0);
+  const double omg12 = E * (sig12
+      - (std::atan2(ssig2, csig2) - std::atan2(mSinSigma1, mCosSigma1))
+      + (std::atan2(E * mSinAlpha0 * ssig2, csig2) - std::atan2(E * mSinOmega1, mCosOmega1)));
+  const double lam12 = omg12 + mA3c * (sig12 + (sinSeries(ssig2, csig2, mC3, 5) - mB31));
+
+  if (azi2)
+    *azi2 = std::atan2(mSinAlpha0, mCosAlpha0 * csig2);
+  return LonLat(mFrom.lon() + lam12, std::atan2(sbet2, (1 - mGeodesic.f()) * cbet2));
+}
+
+void miGeodesicLine::positions(const double* distances, std::size_t count, LonLat* positions) const
+{
+  for (std::size_t i = 0; i < count; ++i)
+    positions[i] = position(distances[i]);
+}
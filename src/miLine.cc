@@ -47,6 +47,8 @@ void miLine::set(const miCoordinates& beg_, const miCoordinates& end_)
   Y1 = beg_.dLat();
   X2 = end_.dLon();
   Y2 = end_.dLat();
+  P1 = miPredicates::Point(beg_);
+  P2 = miPredicates::Point(end_);
 
   is_v = ( beg_.iLon() == end_.iLon() );
   is_h = ( beg_.iLat() == end_.iLat() );
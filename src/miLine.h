@@ -30,12 +30,14 @@
 #define _miLine_h
 
 #include "miCoordinates.h"
+#include "miPredicates.h"
 
 class miLine {
 private:
   float X1,Y1;             // begin
   float X2,Y2;             // end
   float A,B;               // y = Ax + B
+  miPredicates::Point P1,P2; // begin and end in centiminutes
   bool out_of_range(const float&,const float&, const float&) const;
   bool is_v;
   bool is_h;
@@ -46,11 +48,19 @@ public:
   void set( const miCoordinates& beg_, const miCoordinates& end_);
 
   bool cross(         const miLine& tc                    ) const;
+  // exact test in centiminutes, true if the lines touch or overlap
+  bool crossExact(    const miLine& tc                    ) const
+    { return miPredicates::segmentsIntersect(P1,P2,tc.P1,tc.P2); }
   bool crossingPoint( const miLine& tc, miCoordinates& mic) const;
   
+  void endpoints(float& x1, float& y1, float& x2, float& y2) const
+    { x1 = X1; y1 = Y1; x2 = X2; y2 = Y2; }
+
   miCoordinates middle();
   miCoordinates begin() const { return miCoordinates(X1,Y1); }
   miCoordinates end()   const { return miCoordinates(X2,Y2); }
+  const miPredicates::Point& pBegin() const { return P1; }
+  const miPredicates::Point& pEnd()   const { return P2; }
 };
 
 #endif
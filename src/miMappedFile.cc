@@ -0,0 +1,88 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miMappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+const char EMPTY[1] = { 0 };
+} // namespace
+
+miMappedFile::miMappedFile()
+  : mData(0)
+  , mSize(0)
+  , mMapped(false)
+{
+}
+
+miMappedFile::~miMappedFile()
+{
+  close();
+}
+
+bool miMappedFile::open(const std::string& filename)
+{
+  close();
+
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    ::close(fd);
+    return false;
+  }
+
+  if (st.st_size == 0) {
+    mData = EMPTY;
+  } else {
+    void* m = ::mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m != MAP_FAILED) {
+      ::madvise(m, st.st_size, MADV_SEQUENTIAL);
+      mData = static_cast<const char*>(m);
+      mSize = st.st_size;
+      mMapped = true;
+    }
+  }
+  ::close(fd);
+  return mData != 0;
+}
+
+void miMappedFile::close()
+{
+  if (mMapped)
+    ::munmap(const_cast<char*>(mData), mSize);
+  mData = 0;
+  mSize = 0;
+  mMapped = false;
+}
@@ -0,0 +1,67 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miMappedFile_h
+#define puDatatypes_miMappedFile_h
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/*! Read-only memory mapping of a whole file.
+ *  The mapping is released when the object is destroyed.
+ */
+class miMappedFile {
+public:
+  miMappedFile();
+  ~miMappedFile();
+
+  miMappedFile(const miMappedFile&) = delete;
+  miMappedFile& operator=(const miMappedFile&) = delete;
+
+  //! map 'filename', releasing any previous mapping; returns false if it cannot be mapped
+  bool open(const std::string& filename);
+
+  //! release the mapping
+  void close();
+
+  bool isOpen() const { return mData != 0; }
+
+  const char* data() const { return mData; }
+  std::size_t size() const { return mSize; }
+
+  //! the file contents; empty if not open
+  std::string_view view() const { return std::string_view(mData, mSize); }
+
+private:
+  const char* mData;
+  std::size_t mSize;
+  bool mMapped; // false for empty files, which cannot be mapped
+};
+
+#endif // puDatatypes_miMappedFile_h
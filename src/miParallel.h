@@ -0,0 +1,91 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miParallel_h
+#define puDatatypes_miParallel_h
+
+// internal helpers for running work on several threads; not installed
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace miParallel {
+
+//! number of threads to use for 'requested' (0 = one per hardware thread) and at most 'tasks' tasks
+inline unsigned int threadCount(unsigned int requested, std::size_t tasks)
+{
+  if (requested == 0)
+    requested = std::max(1u, std::thread::hardware_concurrency());
+  return unsigned(std::max<std::size_t>(1, std::min<std::size_t>(requested, tasks)));
+}
+
+//! call 'work(t)' for t = 0 .. threads-1, each on its own thread, and wait for all
+template<class F>
+void run(unsigned int threads, const F& work)
+{
+  std::vector<std::thread> pool;
+  for (unsigned int t = 1; t < threads; ++t)
+    pool.push_back(std::thread([&work, t]() { work(t); }));
+  work(0u);
+  for (std::size_t t = 0; t < pool.size(); ++t)
+    pool[t].join();
+}
+
+/*! Sort [begin, end) with 'threads' threads: each sorts one chunk, then
+ *  neighbouring chunks are merged pairwise, also in parallel. 'less' must
+ *  be safe to call from several threads.
+ */
+template<class It, class Less>
+void sort(It begin, It end, const Less& less, unsigned int threads)
+{
+  const std::size_t n = end - begin;
+  threads = threadCount(threads, n / 1024);
+  std::vector<std::size_t> bounds(threads + 1);
+  for (unsigned int t = 0; t <= threads; ++t)
+    bounds[t] = n * t / threads;
+
+  run(threads, [&](unsigned int t) {
+      std::sort(begin + bounds[t], begin + bounds[t+1], less);
+    });
+  for (std::size_t width = 1; width < threads; width *= 2) {
+    const unsigned int merges = unsigned((threads + 2*width - 1) / (2*width));
+    run(merges, [&](unsigned int m) {
+        const std::size_t first = 2*width*m, middle = first + width;
+        if (middle < threads) {
+          const std::size_t last = std::min<std::size_t>(middle + width, threads);
+          std::inplace_merge(begin + bounds[first], begin + bounds[middle], begin + bounds[last], less);
+        }
+      });
+  }
+}
+
+} // namespace miParallel
+
+#endif // puDatatypes_miParallel_h
@@ -0,0 +1,52 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miParse_h
+#define puDatatypes_miParse_h
+
+// internal helpers for parsing text fields; not installed
+
+#include <charconv>
+#include <string_view>
+
+namespace miParse {
+
+//! parse all of 'word' as a number, allowing a leading '+' like lexical_cast
+template<class T>
+bool number(std::string_view word, T& value)
+{
+  if (word.size() > 1 && word[0] == '+' && word[1] != '-')
+    word.remove_prefix(1);
+  const char* const end = word.data() + word.size();
+  const std::from_chars_result r = std::from_chars(word.data(), end, value);
+  return r.ec == std::errc() && r.ptr == end;
+}
+
+} // namespace miParse
+
+#endif // puDatatypes_miParse_h
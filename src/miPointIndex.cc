@@ -0,0 +1,213 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miPointIndex.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace {
+
+inline double chord2(const double a[3], const double b[3])
+{
+  const double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+  return dx*dx + dy*dy + dz*dz;
+}
+
+// candidate for nearest neighbours, ordered by chord and then index
+struct Candidate {
+  double chord2;
+  std::size_t index;
+  Candidate(double c, std::size_t i) : chord2(c), index(i) { }
+  bool operator<(const Candidate& o) const
+    { return chord2 < o.chord2 || (chord2 == o.chord2 && index < o.index); }
+};
+
+} // namespace
+
+struct miPointIndex::Query {
+  double xyz[3];
+  std::size_t k;
+  const accept_f* accept;
+  std::priority_queue<Candidate> best; // worst candidate on top
+
+  bool full() const
+    { return best.size() >= k; }
+  double worst() const
+    { return best.top().chord2; }
+};
+
+miPointIndex::miPointIndex(const std::vector<LonLat>& points)
+  : mNodes(points.size())
+  , mNodeOf(points.size())
+{
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    PreparedLonLat(points[i]).unitVector(mNodes[i].xyz);
+    mNodes[i].index = i;
+  }
+  build(0, mNodes.size());
+  for (std::size_t n = 0; n < mNodes.size(); ++n)
+    mNodeOf[mNodes[n].index] = n;
+}
+
+// balanced tree stored implicitly: the median of [begin, end) is the node,
+// the halves before and after it are the subtrees
+void miPointIndex::build(std::size_t begin, std::size_t end)
+{
+  if (end - begin < 2) {
+    if (begin < end)
+      mNodes[begin].axis = 0;
+    return;
+  }
+
+  double lo[3] = {  2,  2,  2 };
+  double hi[3] = { -2, -2, -2 };
+  for (std::size_t i = begin; i < end; ++i) {
+    for (int a = 0; a < 3; ++a) {
+      lo[a] = std::min(lo[a], mNodes[i].xyz[a]);
+      hi[a] = std::max(hi[a], mNodes[i].xyz[a]);
+    }
+  }
+  int axis = 0;
+  for (int a = 1; a < 3; ++a)
+    if (hi[a] - lo[a] > hi[axis] - lo[axis])
+      axis = a;
+
+  const std::size_t mid = begin + (end - begin) / 2;
+  std::nth_element(mNodes.begin() + begin, mNodes.begin() + mid, mNodes.begin() + end,
+      [axis](const Node& a, const Node& b) { return a.xyz[axis] < b.xyz[axis]; });
+  mNodes[mid].axis = axis;
+
+  build(begin, mid);
+  build(mid + 1, end);
+}
+
+void miPointIndex::search(std::size_t begin, std::size_t end, Query& q) const
+{
+  if (begin >= end)
+    return;
+
+  const std::size_t mid = begin + (end - begin) / 2;
+  const Node& node = mNodes[mid];
+  if (!q.accept || (*q.accept)(node.index)) {
+    const Candidate c(chord2(q.xyz, node.xyz), node.index);
+    if (!q.full()) {
+      q.best.push(c);
+    } else if (c < q.best.top()) {
+      q.best.pop();
+      q.best.push(c);
+    }
+  }
+
+  const double diff = q.xyz[node.axis] - node.xyz[node.axis];
+  const bool lower = (diff < 0);
+  if (lower)
+    search(begin, mid, q);
+  else
+    search(mid + 1, end, q);
+  if (!q.full() || diff*diff <= q.worst()) {
+    if (lower)
+      search(mid + 1, end, q);
+    else
+      search(begin, mid, q);
+  }
+}
+
+void miPointIndex::nearest(const LonLat& p, std::size_t k, std::vector<std::size_t>& indices,
+    std::vector<double>* distances) const
+{
+  indices.clear();
+  if (distances)
+    distances->clear();
+  if (k == 0)
+    return;
+
+  Query q;
+  PreparedLonLat(p).unitVector(q.xyz);
+  q.k = k;
+  q.accept = 0;
+  search(0, mNodes.size(), q);
+
+  const std::size_t n = q.best.size();
+  indices.resize(n);
+  if (distances)
+    distances->resize(n);
+  for (std::size_t i = n; i > 0; --i) {
+    indices[i-1] = q.best.top().index;
+    if (distances)
+      (*distances)[i-1] = distanceForChord2(q.best.top().chord2);
+    q.best.pop();
+  }
+}
+
+bool miPointIndex::nearest(const LonLat& p, const accept_f& accept, std::size_t& index, double& distance) const
+{
+  Query q;
+  PreparedLonLat(p).unitVector(q.xyz);
+  q.k = 1;
+  q.accept = &accept;
+  search(0, mNodes.size(), q);
+  if (q.best.empty())
+    return false;
+
+  index = q.best.top().index;
+  distance = distanceForChord2(q.best.top().chord2);
+  return true;
+}
+
+void miPointIndex::searchWithin(std::size_t begin, std::size_t end, const double xyz[3], double c2,
+    std::vector<std::size_t>& indices) const
+{
+  if (begin >= end)
+    return;
+
+  const std::size_t mid = begin + (end - begin) / 2;
+  const Node& node = mNodes[mid];
+  if (chord2(xyz, node.xyz) <= c2)
+    indices.push_back(node.index);
+
+  const double diff = xyz[node.axis] - node.xyz[node.axis];
+  if (diff < 0 || diff*diff <= c2)
+    searchWithin(begin, mid, xyz, c2, indices);
+  if (diff >= 0 || diff*diff <= c2)
+    searchWithin(mid + 1, end, xyz, c2, indices);
+}
+
+void miPointIndex::within(const LonLat& p, double radius, std::vector<std::size_t>& indices) const
+{
+  indices.clear();
+  double xyz[3];
+  PreparedLonLat(p).unitVector(xyz);
+  searchWithin(0, mNodes.size(), xyz, chord2ForDistance(radius), indices);
+  std::sort(indices.begin(), indices.end());
+}
+
+void miPointIndex::unitVector(std::size_t index, double xyz[3]) const
+{
+  const Node& node = mNodes[mNodeOf[index]];
+  std::copy(node.xyz, node.xyz + 3, xyz);
+}
@@ -0,0 +1,93 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miPointIndex_h
+#define puDatatypes_miPointIndex_h
+
+#include "miCoordinates.h"
+
+#include <functional>
+#include <vector>
+
+/*! k-d tree over points on the sphere, for nearest neighbour and radius queries.
+ *
+ *  The points are stored as unit vectors, where the euclidean (chord)
+ *  distance is monotone in the great circle distance. Queries therefore
+ *  need no trigonometry except for converting the query point and the
+ *  returned distances. Points are identified by their index in the
+ *  vector given to the constructor; ties are broken by index, so results
+ *  are deterministic.
+ */
+class miPointIndex {
+public:
+  typedef std::function<bool(std::size_t)> accept_f;
+
+  miPointIndex() {}
+  explicit miPointIndex(const std::vector<LonLat>& points);
+
+  std::size_t size() const
+    { return mNodes.size(); }
+
+  /*! find the 'k' points nearest to 'p', nearest first
+   *
+   *  \param indices indices of the points found
+   *  \param distances if not null, great circle distances in m
+   */
+  void nearest(const LonLat& p, std::size_t k, std::vector<std::size_t>& indices,
+      std::vector<double>* distances = 0) const;
+
+  /*! find the nearest point for which 'accept' returns true
+   *
+   *  \return false if no point was accepted
+   */
+  bool nearest(const LonLat& p, const accept_f& accept, std::size_t& index, double& distance) const;
+
+  //! find all points within 'radius' m from 'p', sorted by index
+  void within(const LonLat& p, double radius, std::vector<std::size_t>& indices) const;
+
+  //! unit vector of point 'index' in the constructor argument
+  void unitVector(std::size_t index, double xyz[3]) const;
+
+private:
+  struct Node {
+    double xyz[3];
+    std::size_t index;
+    int axis;
+  };
+  struct Query;
+
+  void build(std::size_t begin, std::size_t end);
+  void search(std::size_t begin, std::size_t end, Query& q) const;
+  void searchWithin(std::size_t begin, std::size_t end, const double xyz[3], double chord2,
+      std::vector<std::size_t>& indices) const;
+
+  std::vector<Node> mNodes;
+  std::vector<std::size_t> mNodeOf; // node position of each point
+};
+
+#endif // puDatatypes_miPointIndex_h
@@ -29,6 +29,9 @@
 
 #include "miPosition.h"
 
+#include "miParallel.h"
+
+#include <cstdint>
 #include <sstream>
 
 using namespace std;
@@ -39,25 +42,25 @@ miPosition::sort_mode miPosition::smode_= miPosition::sort_name;
 void miPosition::setPos(const miCoordinates& pos,
 			const int synop,
 			const int dbkey,
-			const std::string& name,
+			std::string_view name,
 			const int hoh,
 			const int priority,
-			const std::string group ){
+			std::string_view group ){
   pos_      = pos;
   synop_    = synop;
   dbKey_    = dbkey;
-  name_     = name;
+  name_     = miSymbol(name);
   hoh_      = hoh;
   priority_ = priority;
-  group_    = group;
+  group_    = miSymbol(group);
 };
 
 
 ostream& operator<<(ostream& out, const miPosition& rhs){
-  out << "miPosition -- Name: " << rhs.name_ <<
+  out << "miPosition -- Name: " << rhs.Name() <<
     " synop: " <<  rhs.synop_ << " dbKey: " << rhs.dbKey_ <<
     " hoh: " << rhs.hoh_ << " priority: " << rhs.priority_ <<
-    " group: " << rhs.group_ << " Coordinates: " << rhs.pos_;
+    " group: " << rhs.Group() << " Coordinates: " << rhs.pos_;
  return out;
 };
 
@@ -114,7 +117,7 @@ bool operator==(const miPosition& lhs, const miPosition& rhs)
 
 bool operator==(const miPosition& lhs, const std::string& rhs)
 {
-  return lhs.name_ == rhs ;
+  return lhs.Name() == rhs ;
 }
 
 bool operator==(const miPosition& lhs, const int& rhs)
@@ -151,3 +154,112 @@ bool operator>=(const miPosition& lhs, const miPosition& rhs)
 
 
 
+
+miPositionLess::miPositionLess(miPosition::sort_mode mode, const miCoordinates& origo)
+  : mode_(mode)
+  , origo_(origo)
+{
+}
+
+bool miPositionLess::operator()(const miPosition& lhs, const miPosition& rhs) const
+{
+  switch (mode_) {
+  case miPosition::sort_synop:
+    return lhs.Synop() < rhs.Synop();
+  case miPosition::sort_lat:
+    return lhs.lat() < rhs.lat();
+  case miPosition::sort_lon:
+    return lhs.lon() < rhs.lon();
+  case miPosition::sort_dbkey:
+    return lhs.DbKey() < rhs.DbKey();
+  case miPosition::sort_distance:
+    return origo_.distanceTo(lhs.Coordinates()) < origo_.distanceTo(rhs.Coordinates());
+  case miPosition::sort_name:
+  default:
+    return lhs.Name() < rhs.Name();
+  }
+}
+
+namespace {
+
+struct SortEntry {
+  double key;
+  uint32_t index;
+};
+
+struct SortEntryLess {
+  bool operator()(const SortEntry& a, const SortEntry& b) const
+    { return a.key < b.key || (a.key == b.key && a.index < b.index); }
+};
+
+struct NameLess {
+  const std::vector<miPosition>& positions;
+  bool operator()(uint32_t a, uint32_t b) const
+    {
+      const int c = positions[a].Name().compare(positions[b].Name());
+      return c < 0 || (c == 0 && a < b);
+    }
+};
+
+double sortKey(const miPosition& p, miPosition::sort_mode mode, const PreparedLonLat& origo)
+{
+  switch (mode) {
+  case miPosition::sort_synop:
+    return p.Synop();
+  case miPosition::sort_lat:
+    return p.lat();
+  case miPosition::sort_lon:
+    return p.lon();
+  case miPosition::sort_dbkey:
+    return p.DbKey();
+  case miPosition::sort_distance:
+    // the chord increases with the distance and needs no asin
+    return origo.chord2To(PreparedLonLat(p.Coordinates().lonLat()));
+  default:
+    return 0;
+  }
+}
+
+} // namespace
+
+void sortPositions(std::vector<miPosition>& positions, miPosition::sort_mode mode,
+    const miCoordinates& origo, unsigned int threads)
+{
+  const std::size_t n = positions.size();
+  std::vector<uint32_t> order(n);
+  if (mode == miPosition::sort_name || mode > miPosition::sort_distance) {
+    for (std::size_t i = 0; i < n; ++i)
+      order[i] = uint32_t(i);
+    miParallel::sort(order.begin(), order.end(), NameLess{positions}, threads);
+  } else {
+    const PreparedLonLat porigo(origo.lonLat());
+    std::vector<SortEntry> entries(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      entries[i].key = sortKey(positions[i], mode, porigo);
+      entries[i].index = uint32_t(i);
+    }
+    miParallel::sort(entries.begin(), entries.end(), SortEntryLess(), threads);
+    for (std::size_t i = 0; i < n; ++i)
+      order[i] = entries[i].index;
+  }
+
+  std::vector<miPosition> sorted;
+  sorted.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    sorted.push_back(std::move(positions[order[i]]));
+  positions.swap(sorted);
+}
+
+void formatCoordinates(const std::vector<miPosition>& positions,
+    std::string& text, std::vector<std::size_t>& offsets)
+{
+  text.resize(positions.size() * miCoordinates::STR_MAX_SIZE);
+  offsets.resize(positions.size() + 1);
+  offsets[0] = 0;
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    n += positions[i].Coordinates().str(&text[n], text.size() - n);
+    offsets[i+1] = n;
+  }
+  text.resize(n);
+}
@@ -34,6 +34,13 @@
 // JS/PU 8/99
 
 #include "miCoordinates.h"
+#include "miSymbol.h"
+
+#include <string_view>
+#include <vector>
+
+// names, groups and ICAO ids are interned as miSymbol, so that a
+// miPosition has a small fixed size and copies without allocation
 
 class miPosition {
 public:
@@ -44,11 +51,11 @@ private:
   miCoordinates pos_;
   int synop_;
   int dbKey_;
-  std::string name_;
   int hoh_;
   int priority_;
-  std::string group_;
-  std::string icaoid_;
+  miSymbol name_;
+  miSymbol group_;
+  miSymbol icaoid_;
 
   static sort_mode smode_;
   static miCoordinates origo_;
@@ -57,36 +64,36 @@ private:
 public:
   miPosition():synop_(0),dbKey_(0),hoh_(0),priority_(0){}
   miPosition(const miCoordinates& pos, const int synop,
-	     const int dbkey, const std::string& name,
+	     const int dbkey, std::string_view name,
 	     const int hoh = 0, const int priority = 0,
-	     const std::string group = "")
+	     std::string_view group = std::string_view())
   {setPos(pos,synop,dbkey,name,hoh,priority,group);}
 
   void setPos(const miCoordinates& pos, const int synop, const int dbkey,
-	      const std::string& name, const int hoh= 0,
-	      const int priority= 0, const std::string group= "");
+	      std::string_view name, const int hoh= 0,
+	      const int priority= 0, std::string_view group= std::string_view());
 
   void setDbKey(const int i)           { dbKey_  = i;     }
   void setCoor(const miCoordinates& c) { pos_    = c;     }
   void setLat(const float& l)          { pos_.setLat(l);  }
   void setLon(const float& l)          { pos_.setLon(l);  }
   void setHoH(const int h)             { hoh_    = h;     }
-  void setName(const  std::string& name)  { name_   = name;  }
-  void setIcao(const  std::string& icaoid){ icaoid_ = icaoid;}
-  void setGroup(const std::string& group) { group_  = group; }
+  void setName(std::string_view name)     { name_   = miSymbol(name);   }
+  void setIcao(std::string_view icaoid)   { icaoid_ = miSymbol(icaoid); }
+  void setGroup(std::string_view group)   { group_  = miSymbol(group);  }
 
   float lon() const {return pos_.dLon();}
   float lat() const {return pos_.dLat();}
 
   const miCoordinates& Coordinates() const {return pos_;}
 
-  const std::string& Name() const {return name_;}
+  std::string_view Name() const {return name_.str();}
   int Synop()     const {return synop_;}
   int DbKey()     const {return dbKey_;}
   int height()    const {return hoh_;}
   int Priority()  const {return priority_;}
-  const std::string& Group()  const {return group_;}
-  const std::string& icaoID() const {return icaoid_;}
+  std::string_view Group()  const {return group_.str();}
+  std::string_view icaoID() const {return icaoid_.str();}
 
   int distance(const miPosition& pos) const
   { return pos_.distance(pos.Coordinates()); }
@@ -97,8 +104,10 @@ public:
   bool isInRect(const miCoordinates& nw,const miCoordinates& se ) const
   { return pos_.isInRect(nw,se); }
 
-  bool isGrp(const std::string & group ) const { return group == group_ ;}
+  bool isGrp(std::string_view group ) const { return group == group_.str() ;}
 
+  // the sort mode and origo used by the comparison operators are shared
+  // by all threads; see miPositionLess and sortPositions for alternatives
   static void setSortMode(sort_mode smode){smode_= smode;}
   static void setSortOrigo(const miCoordinates& c){origo_=c;}
 
@@ -115,6 +124,43 @@ public:
 
 };
 
+/*! Comparison of positions by one sort mode.
+ *
+ *  Unlike operator<, this does not use the static sort mode and origo,
+ *  so different threads may sort by different modes at the same time.
+ *  sort_distance compares the exact distances to 'origo' instead of
+ *  whole km.
+ */
+class miPositionLess {
+public:
+  explicit miPositionLess(miPosition::sort_mode mode,
+      const miCoordinates& origo = miCoordinates(float(0.0), float(89.9)));
+
+  bool operator()(const miPosition& lhs, const miPosition& rhs) const;
+
+private:
+  miPosition::sort_mode mode_;
+  miPreparedCoordinates origo_;
+};
+
+/*! Sort 'positions' as with miPositionLess, with positions comparing
+ *  equal kept in their original order.
+ *
+ *  The sort key of each position, e.g. the chord to 'origo' for
+ *  sort_distance, is computed once. 'threads' is the number of threads
+ *  to use; 0 uses one per hardware thread.
+ */
+void sortPositions(std::vector<miPosition>& positions, miPosition::sort_mode mode,
+    const miCoordinates& origo = miCoordinates(float(0.0), float(89.9)),
+    unsigned int threads = 0);
+
+/*! Format the coordinates of all positions, as miCoordinates::str(),
+ *  into one buffer. The label for positions[i] is the text from
+ *  offsets[i] to offsets[i+1].
+ */
+void formatCoordinates(const std::vector<miPosition>& positions,
+    std::string& text, std::vector<std::size_t>& offsets);
+
 #endif
 
 
@@ -0,0 +1,87 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miPositionIndex.h"
+
+namespace {
+
+std::vector<LonLat> toLonLats(const std::vector<miPosition>& positions)
+{
+  std::vector<LonLat> points;
+  points.reserve(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i)
+    points.push_back(positions[i].Coordinates().lonLat());
+  return points;
+}
+
+} // namespace
+
+miPositionIndex::miPositionIndex(const std::vector<miPosition>& positions)
+  : mPositions(positions)
+  , mPoints(toLonLats(positions))
+{
+}
+
+void miPositionIndex::nearest(const miCoordinates& c, std::size_t k, std::vector<std::size_t>& indices,
+    std::vector<double>* distances) const
+{
+  mPoints.nearest(c.lonLat(), k, indices, distances);
+}
+
+bool miPositionIndex::nearest(const miCoordinates& c, std::size_t& index, double& distance) const
+{
+  std::vector<std::size_t> indices;
+  std::vector<double> distances;
+  mPoints.nearest(c.lonLat(), 1, indices, &distances);
+  if (indices.empty())
+    return false;
+  index = indices.front();
+  distance = distances.front();
+  return true;
+}
+
+bool miPositionIndex::nearest(const miCoordinates& c, const accept_f& accept, std::size_t& index, double& distance) const
+{
+  const std::vector<miPosition>& positions = mPositions;
+  const miPointIndex::accept_f acceptIndex = [&positions, &accept](std::size_t i) { return accept(positions[i]); };
+  return mPoints.nearest(c.lonLat(), acceptIndex, index, distance);
+}
+
+bool miPositionIndex::nearestInGroup(const miCoordinates& c, const std::string& group, std::size_t& index, double& distance) const
+{
+  return nearest(c, [&group](const miPosition& p) { return p.isGrp(group); }, index, distance);
+}
+
+bool miPositionIndex::nearestWithPriority(const miCoordinates& c, int priority, std::size_t& index, double& distance) const
+{
+  return nearest(c, [priority](const miPosition& p) { return p.Priority() >= priority; }, index, distance);
+}
+
+void miPositionIndex::within(const miCoordinates& c, double radius, std::vector<std::size_t>& indices) const
+{
+  mPoints.within(c.lonLat(), radius, indices);
+}
@@ -0,0 +1,81 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miPositionIndex_h
+#define puDatatypes_miPositionIndex_h
+
+#include "miPointIndex.h"
+#include "miPosition.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/*! Spatial index over a list of positions, for nearest station queries.
+ *
+ *  The index keeps a copy of the positions. Results are indices into the
+ *  list given to the constructor.
+ */
+class miPositionIndex {
+public:
+  typedef std::function<bool(const miPosition&)> accept_f;
+
+  miPositionIndex() {}
+  explicit miPositionIndex(const std::vector<miPosition>& positions);
+
+  const std::vector<miPosition>& positions() const
+    { return mPositions; }
+
+  std::size_t size() const
+    { return mPositions.size(); }
+
+  //! the 'k' positions nearest to 'c', nearest first; distances in m
+  void nearest(const miCoordinates& c, std::size_t k, std::vector<std::size_t>& indices,
+      std::vector<double>* distances = 0) const;
+
+  //! the nearest position; returns false if there are no positions
+  bool nearest(const miCoordinates& c, std::size_t& index, double& distance) const;
+
+  //! the nearest position for which 'accept' returns true; returns false if none is accepted
+  bool nearest(const miCoordinates& c, const accept_f& accept, std::size_t& index, double& distance) const;
+
+  //! the nearest position in 'group'
+  bool nearestInGroup(const miCoordinates& c, const std::string& group, std::size_t& index, double& distance) const;
+
+  //! the nearest position with priority at least 'priority'
+  bool nearestWithPriority(const miCoordinates& c, int priority, std::size_t& index, double& distance) const;
+
+  //! all positions within 'radius' m from 'c', sorted by index
+  void within(const miCoordinates& c, double radius, std::vector<std::size_t>& indices) const;
+
+private:
+  std::vector<miPosition> mPositions;
+  miPointIndex mPoints;
+};
+
+#endif // puDatatypes_miPositionIndex_h
@@ -0,0 +1,174 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miPositionLoader.h"
+
+#include "miMappedFile.h"
+#include "miParallel.h"
+#include "miParse.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// do not spread small catalogs over many threads
+const std::size_t MIN_CHUNK_SIZE = 64*1024;
+
+// split off the next field, leaving the rest in 'line'
+std::string_view nextField(std::string_view& line, char delimiter)
+{
+  const std::size_t d = line.find(delimiter);
+  const std::string_view field = line.substr(0, d);
+  if (d == std::string_view::npos)
+    line = std::string_view();
+  else
+    line.remove_prefix(d + 1);
+  return field;
+}
+
+std::size_t countLines(const char* begin, const char* end)
+{
+  std::size_t lines = 0;
+  while (begin < end) {
+    const char* nl = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+    lines += 1;
+    if (!nl)
+      break;
+    begin = nl + 1;
+  }
+  return lines;
+}
+
+} // namespace
+
+miPositionLoader::miPositionLoader(char delimiter, unsigned int threads)
+  : mDelimiter(delimiter)
+  , mThreads(threads)
+{
+}
+
+bool miPositionLoader::parseLine(std::string_view line, miPosition& position) const
+{
+  int synop, dbkey;
+  if (!miParse::number(nextField(line, mDelimiter), synop)
+      || !miParse::number(nextField(line, mDelimiter), dbkey))
+    return false;
+  const std::string_view name = nextField(line, mDelimiter);
+  float lon, lat;
+  if (!miParse::number(nextField(line, mDelimiter), lon)
+      || !miParse::number(nextField(line, mDelimiter), lat)
+      || !(lon >= -180 && lon <= 180 && lat >= -90 && lat <= 90)) // also rejects nan
+    return false;
+
+  int hoh = 0, priority = 0;
+  const std::string_view h = nextField(line, mDelimiter);
+  if (!h.empty() && !miParse::number(h, hoh))
+    return false;
+  const std::string_view p = nextField(line, mDelimiter);
+  if (!p.empty() && !miParse::number(p, priority))
+    return false;
+  const std::string_view group = nextField(line, mDelimiter);
+  const std::string_view icao = nextField(line, mDelimiter);
+  if (!line.empty())
+    return false;
+
+  position.setPos(miCoordinates(lon, lat), synop, dbkey, name, hoh, priority, group);
+  position.setIcao(icao);
+  return true;
+}
+
+std::size_t miPositionLoader::load(std::string_view text, std::vector<miPosition>& positions) const
+{
+  const char* const begin = text.data();
+  const char* const end = begin + text.size();
+
+  // chunk boundaries, each just after a newline
+  const unsigned int threads = miParallel::threadCount(mThreads, text.size() / MIN_CHUNK_SIZE);
+  std::vector<const char*> bounds(threads + 1, end);
+  bounds[0] = begin;
+  for (unsigned int t = 1; t < threads; ++t) {
+    const char* b = std::max(bounds[t-1], begin + text.size() / threads * t);
+    const char* nl = static_cast<const char*>(std::memchr(b, '\n', end - b));
+    bounds[t] = nl ? nl + 1 : end;
+  }
+
+  // count lines to find where each chunk writes its stations
+  std::vector<std::size_t> offsets(threads + 1, positions.size());
+  miParallel::run(threads, [&](unsigned int t) {
+      offsets[t+1] = countLines(bounds[t], bounds[t+1]);
+    });
+  for (unsigned int t = 0; t < threads; ++t)
+    offsets[t+1] += offsets[t];
+  positions.resize(offsets[threads]);
+
+  std::vector<std::size_t> good(threads, 0), bad(threads, 0);
+  miParallel::run(threads, [&](unsigned int t) {
+      miPosition* out = positions.data() + offsets[t];
+      const char* b = bounds[t];
+      const char* const e = bounds[t+1];
+      while (b < e) {
+        const char* nl = static_cast<const char*>(std::memchr(b, '\n', e - b));
+        const char* le = nl ? nl : e;
+        std::string_view line(b, le - b);
+        b = nl ? nl + 1 : e;
+        if (!line.empty() && line.back() == '\r')
+          line.remove_suffix(1);
+        if (line.empty() || line[0] == '#')
+          continue;
+        if (parseLine(line, out[good[t]]))
+          good[t] += 1;
+        else
+          bad[t] += 1;
+      }
+    });
+
+  // close the gaps left by comments, empty and bad lines
+  std::size_t n = offsets[0], nbad = 0;
+  for (unsigned int t = 0; t < threads; ++t) {
+    if (n != offsets[t])
+      std::move(positions.begin() + offsets[t], positions.begin() + offsets[t] + good[t],
+          positions.begin() + n);
+    n += good[t];
+    nbad += bad[t];
+  }
+  positions.resize(n);
+  return nbad;
+}
+
+bool miPositionLoader::loadFile(const std::string& filename, std::vector<miPosition>& positions,
+    std::size_t* badLines) const
+{
+  miMappedFile file;
+  if (!file.open(filename))
+    return false;
+  const std::size_t bad = load(file.view(), positions);
+  if (badLines)
+    *badLines = bad;
+  return true;
+}
@@ -0,0 +1,75 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miPositionLoader_h
+#define puDatatypes_miPositionLoader_h
+
+#include "miPosition.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*! Bulk loader for station catalogs.
+ *
+ *  A catalog has one station per line with the fields
+ *
+ *    synop;dbkey;name;lon;lat[;height[;priority[;group[;icao]]]]
+ *
+ *  where lon and lat are in decimal degrees. The delimiter is
+ *  configurable (use '\\t' for TSV). Empty lines and lines starting
+ *  with '#' are skipped; a trailing '\\r' is ignored.
+ *
+ *  The text is split into chunks at line boundaries which are parsed
+ *  in parallel directly into a preallocated vector.
+ */
+class miPositionLoader {
+public:
+  //! threads = 0 uses one thread per hardware thread
+  explicit miPositionLoader(char delimiter = ';', unsigned int threads = 0);
+
+  //! parse a single catalog line; returns false if it is not a valid station
+  bool parseLine(std::string_view line, miPosition& position) const;
+
+  /*! Parse 'text' and append the stations to 'positions', in file order.
+   *  \returns the number of lines that are neither stations, comments nor empty
+   */
+  std::size_t load(std::string_view text, std::vector<miPosition>& positions) const;
+
+  /*! Memory-map 'filename' and append its stations to 'positions'.
+   *  \returns false if the file cannot be read
+   */
+  bool loadFile(const std::string& filename, std::vector<miPosition>& positions,
+      std::size_t* badLines = 0) const;
+
+private:
+  char mDelimiter;
+  unsigned int mThreads;
+};
+
+#endif // puDatatypes_miPositionLoader_h
@@ -0,0 +1,159 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miPositionTable.h"
+
+#include <cmath>
+
+namespace {
+
+// miCoordinates int constructor argument for total centiminutes
+inline int encodeCmin(int total)
+{
+  return (total / 6000) * 10000 + total % 6000;
+}
+
+} // namespace
+
+miPosition miPositionTable::Row::position() const
+{
+  miPosition p(Coordinates(), Synop(), DbKey(), Name(), height(), Priority(), Group());
+  p.setIcao(icaoID());
+  return p;
+}
+
+miPositionTable::miPositionTable(const std::vector<miPosition>& positions)
+{
+  reserve(positions.size());
+  for (std::size_t i = 0; i < positions.size(); ++i)
+    push_back(positions[i]);
+}
+
+void miPositionTable::reserve(std::size_t count)
+{
+  mLon.reserve(count);
+  mLat.reserve(count);
+  mX.reserve(count);
+  mY.reserve(count);
+  mZ.reserve(count);
+  mSynop.reserve(count);
+  mDbKey.reserve(count);
+  mHeight.reserve(count);
+  mPriority.reserve(count);
+  mName.reserve(count);
+  mGroup.reserve(count);
+  mIcao.reserve(count);
+}
+
+void miPositionTable::push_back(const miPosition& position)
+{
+  const miCoordinates& c = position.Coordinates();
+  mLon.push_back(c.Lon().totalCmin());
+  mLat.push_back(c.Lat().totalCmin());
+  double xyz[3];
+  PreparedLonLat(c.lonLat()).unitVector(xyz);
+  mX.push_back(xyz[0]);
+  mY.push_back(xyz[1]);
+  mZ.push_back(xyz[2]);
+  mSynop.push_back(position.Synop());
+  mDbKey.push_back(position.DbKey());
+  mHeight.push_back(position.height());
+  mPriority.push_back(position.Priority());
+  mName.push_back(mStrings.intern(position.Name()));
+  mGroup.push_back(mStrings.intern(position.Group()));
+  mIcao.push_back(mStrings.intern(position.icaoID()));
+}
+
+void miPositionTable::clear()
+{
+  *this = miPositionTable();
+}
+
+miCoordinates miPositionTable::fromCmin(int lon, int lat)
+{
+  return miCoordinates(encodeCmin(lon), encodeCmin(lat));
+}
+
+void miPositionTable::inRect(const miCoordinates& nw, const miCoordinates& se,
+    std::vector<std::size_t>& indices) const
+{
+  const int west = nw.Lon().totalCmin(), north = nw.Lat().totalCmin();
+  const int east = se.Lon().totalCmin(), south = se.Lat().totalCmin();
+  indices.clear();
+  const int* lon = mLon.data();
+  const int* lat = mLat.data();
+  for (std::size_t i = 0; i < size(); ++i) {
+    if ((lon[i] >= west) & (lon[i] <= east) & (lat[i] >= south) & (lat[i] <= north))
+      indices.push_back(i);
+  }
+}
+
+void miPositionTable::inGroup(std::string_view group, std::vector<std::size_t>& indices) const
+{
+  indices.clear();
+  const miStringPool::id_t id = mStrings.find(group);
+  if (id == miStringPool::NONE)
+    return;
+  for (std::size_t i = 0; i < size(); ++i) {
+    if (mGroup[i] == id)
+      indices.push_back(i);
+  }
+}
+
+void miPositionTable::withinChord2(const miCoordinates& c, double chord2,
+    std::vector<std::size_t>& indices) const
+{
+  double xyz[3];
+  PreparedLonLat(c.lonLat()).unitVector(xyz);
+  indices.clear();
+  const double* x = mX.data();
+  const double* y = mY.data();
+  const double* z = mZ.data();
+  for (std::size_t i = 0; i < size(); ++i) {
+    const double dx = x[i] - xyz[0], dy = y[i] - xyz[1], dz = z[i] - xyz[2];
+    if (dx*dx + dy*dy + dz*dz <= chord2)
+      indices.push_back(i);
+  }
+}
+
+void miPositionTable::within(const miCoordinates& c, double radius, std::vector<std::size_t>& indices) const
+{
+  withinChord2(c, chord2ForDistance(radius), indices);
+}
+
+void miPositionTable::withinKm(const miCoordinates& c, int km, std::vector<std::size_t>& indices) const
+{
+  if (km < 0) {
+    indices.clear();
+  } else if (km == 0) {
+    inRect(c, c, indices);
+  } else {
+    // strictly below the chord for km+1, like isCloserThan
+    withinChord2(c, std::nextafter(chord2ForDistance((km + 1) * 1000.0), 0.0), indices);
+  }
+}
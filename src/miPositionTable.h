@@ -0,0 +1,139 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miPositionTable_h
+#define puDatatypes_miPositionTable_h
+
+#include "miPosition.h"
+#include "miStringPool.h"
+
+#include <string_view>
+#include <vector>
+
+/*! Station list stored column by column.
+ *
+ *  Coordinates are kept as total centiminutes and as unit vectors,
+ *  the numeric fields in one array each, and names, groups and ICAO
+ *  ids as ids into a shared miStringPool. Filters scan only the
+ *  columns they need and return row indices in ascending order.
+ */
+class miPositionTable {
+public:
+  //! read-only view of one row, with the accessors of miPosition
+  class Row {
+  public:
+    Row(const miPositionTable& table, std::size_t index)
+      : mTable(&table), mIndex(index) { }
+
+    std::size_t index() const { return mIndex; }
+
+    miCoordinates Coordinates() const { return mTable->coordinates(mIndex); }
+    float lon() const { return Coordinates().dLon(); }
+    float lat() const { return Coordinates().dLat(); }
+
+    std::string_view Name() const   { return mTable->mStrings.str(mTable->mName[mIndex]); }
+    int Synop() const               { return mTable->mSynop[mIndex]; }
+    int DbKey() const               { return mTable->mDbKey[mIndex]; }
+    int height() const              { return mTable->mHeight[mIndex]; }
+    int Priority() const            { return mTable->mPriority[mIndex]; }
+    std::string_view Group() const  { return mTable->mStrings.str(mTable->mGroup[mIndex]); }
+    std::string_view icaoID() const { return mTable->mStrings.str(mTable->mIcao[mIndex]); }
+
+    int distance(const miCoordinates& c) const
+      { return Coordinates().distance(c); }
+    bool isInRect(const miCoordinates& nw, const miCoordinates& se) const
+      { return Coordinates().isInRect(nw, se); }
+    bool isGrp(std::string_view group) const
+      { return Group() == group; }
+
+    //! a copy as miPosition
+    miPosition position() const;
+
+  private:
+    const miPositionTable* mTable;
+    std::size_t mIndex;
+  };
+
+  miPositionTable() { }
+  explicit miPositionTable(const std::vector<miPosition>& positions);
+
+  void reserve(std::size_t count);
+  void push_back(const miPosition& position);
+  void clear();
+
+  std::size_t size() const
+    { return mSynop.size(); }
+
+  Row operator[](std::size_t index) const
+    { return Row(*this, index); }
+
+  miCoordinates coordinates(std::size_t index) const
+    { return fromCmin(mLon[index], mLat[index]); }
+
+  //! coordinates from total centiminutes, as in the lonCmin and latCmin columns
+  static miCoordinates fromCmin(int lon, int lat);
+
+  //! names, groups and icao ids
+  const miStringPool& strings() const
+    { return mStrings; }
+
+  // columns
+  const int* lonCmin() const   { return mLon.data(); }
+  const int* latCmin() const   { return mLat.data(); }
+  const int* synops() const    { return mSynop.data(); }
+  const int* dbKeys() const    { return mDbKey.data(); }
+  const int* heights() const   { return mHeight.data(); }
+  const int* priorities() const { return mPriority.data(); }
+  const miStringPool::id_t* nameIds() const  { return mName.data(); }
+  const miStringPool::id_t* groupIds() const { return mGroup.data(); }
+  const miStringPool::id_t* icaoIds() const  { return mIcao.data(); }
+
+  //! rows for which miPosition::isInRect(nw, se) is true
+  void inRect(const miCoordinates& nw, const miCoordinates& se, std::vector<std::size_t>& indices) const;
+
+  //! rows for which miPosition::isGrp(group) is true
+  void inGroup(std::string_view group, std::vector<std::size_t>& indices) const;
+
+  //! rows within 'radius' m from 'c', like miPositionIndex::within
+  void within(const miCoordinates& c, double radius, std::vector<std::size_t>& indices) const;
+
+  //! rows for which miCoordinates::isCloserThan(c, km), up to roundoff at the limit
+  void withinKm(const miCoordinates& c, int km, std::vector<std::size_t>& indices) const;
+
+private:
+  void withinChord2(const miCoordinates& c, double chord2, std::vector<std::size_t>& indices) const;
+
+private:
+  std::vector<int> mLon, mLat; //!< total centiminutes
+  std::vector<double> mX, mY, mZ; //!< unit vectors
+  std::vector<int> mSynop, mDbKey, mHeight, mPriority;
+  std::vector<miStringPool::id_t> mName, mGroup, mIcao;
+  miStringPool mStrings;
+};
+
+#endif // puDatatypes_miPositionTable_h
@@ -0,0 +1,73 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miPredicates.h"
+
+#include <algorithm>
+
+namespace miPredicates {
+
+bool onSegment(const Point& p, const Point& a, const Point& b)
+{
+  return cross(a, b, p) == 0
+      && std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x)
+      && std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+bool segmentsIntersect(const Point& a1, const Point& a2, const Point& b1, const Point& b2)
+{
+  const int o1 = orientation(a1, a2, b1);
+  const int o2 = orientation(a1, a2, b2);
+  const int o3 = orientation(b1, b2, a1);
+  const int o4 = orientation(b1, b2, a2);
+
+  if (o1*o2 < 0 && o3*o4 < 0)
+    return true;
+
+  // touching or collinear
+  return (o1 == 0 && onSegment(b1, a1, a2))
+      || (o2 == 0 && onSegment(b2, a1, a2))
+      || (o3 == 0 && onSegment(a1, b1, b2))
+      || (o4 == 0 && onSegment(a2, b1, b2));
+}
+
+bool crossesEdge(const Point& o, const Point& p, const Point& a, const Point& b)
+{
+  // a corner on the line o-p counts as left of it
+  const bool aLeft = cross(o, p, a) >= 0;
+  const bool bLeft = cross(o, p, b) >= 0;
+  if (aLeft == bLeft)
+    return false;
+
+  // the edge crosses the line o-p; check that o and p are not on the same side of the edge
+  const int so = orientation(a, b, o);
+  const int sp = orientation(a, b, p);
+  return so*sp <= 0;
+}
+
+} // namespace miPredicates
@@ -0,0 +1,93 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miPredicates_h
+#define puDatatypes_miPredicates_h
+
+#include "miCoordinates.h"
+
+#include <cstdint>
+
+/*! Exact geometric predicates on the centiminute lattice of miCoordinates.
+ *
+ *  Points have integer longitude and latitude in centiminutes. The
+ *  coordinates are at most 180*6000 in magnitude, so all products fit
+ *  easily in 64 bits. No result depends on rounding, and no division is
+ *  needed. Lines are straight in longitude/latitude, as in miLine.
+ */
+namespace miPredicates {
+
+struct Point {
+  int64_t x; //!< longitude in centiminutes
+  int64_t y; //!< latitude in centiminutes
+
+  Point()
+    : x(0), y(0) { }
+  Point(int64_t x_, int64_t y_)
+    : x(x_), y(y_) { }
+  explicit Point(const miCoordinates& c)
+    : x(c.Lon().totalCmin()), y(c.Lat().totalCmin()) { }
+
+  bool operator==(const Point& o) const
+    { return x == o.x && y == o.y; }
+  bool operator!=(const Point& o) const
+    { return !(*this == o); }
+};
+
+//! twice the signed area of the triangle a, b, c
+inline int64_t cross(const Point& a, const Point& b, const Point& c)
+{
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+//! 1 if a, b, c turn counterclockwise, -1 if clockwise, 0 if collinear
+inline int orientation(const Point& a, const Point& b, const Point& c)
+{
+  const int64_t d = cross(a, b, c);
+  return (d > 0) - (d < 0);
+}
+
+//! true if p lies on the closed segment a-b
+bool onSegment(const Point& p, const Point& a, const Point& b);
+
+//! true if the closed segments a1-a2 and b1-b2 have at least one point in common
+bool segmentsIntersect(const Point& a1, const Point& a2, const Point& b1, const Point& b2);
+
+/*! True if the segment o-p crosses the edge a-b, for counting crossings
+ *  in a point-in-polygon test.
+ *
+ *  Corners lying exactly on the line through o and p are treated as if
+ *  they were slightly to its left. Thus a segment through a corner
+ *  crosses either none or both of the edges meeting there, as it should
+ *  for the parity of the count. Edges along the segment never count.
+ */
+bool crossesEdge(const Point& o, const Point& p, const Point& a, const Point& b);
+
+} // namespace miPredicates
+
+#endif // puDatatypes_miPredicates_h
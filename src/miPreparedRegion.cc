@@ -0,0 +1,123 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miPreparedRegion.h"
+
+#include <algorithm>
+
+miPreparedRegion::miPreparedRegion(const miRegions& region)
+  : mLonMin(0), mLonMax(-1), mLatMin(0), mLatMax(-1), mBandHeight(1)
+{
+  const std::vector<miLine>& border = region.getBorders();
+
+  // horizontal lines are never crossed by an eastward ray
+  std::vector<Edge> edges;
+  edges.reserve(border.size());
+  for (std::size_t i = 0; i < border.size(); ++i) {
+    miPredicates::Point a = border[i].pBegin(), b = border[i].pEnd();
+    if (i == 0) {
+      mLonMin = mLonMax = a.x;
+      mLatMin = mLatMax = a.y;
+    }
+    mLonMin = std::min(mLonMin, std::min(a.x, b.x));
+    mLonMax = std::max(mLonMax, std::max(a.x, b.x));
+    mLatMin = std::min(mLatMin, std::min(a.y, b.y));
+    mLatMax = std::max(mLatMax, std::max(a.y, b.y));
+    if (a.y == b.y)
+      continue;
+    if (a.y > b.y)
+      std::swap(a, b);
+    const Edge e = { int32_t(a.x), int32_t(a.y), int32_t(b.x), int32_t(b.y) };
+    edges.push_back(e);
+  }
+  if (edges.empty())
+    return;
+
+  const int64_t height = mLatMax - mLatMin;
+  const int64_t bands = std::max<int64_t>(1, std::min<int64_t>(height, edges.size()));
+  mBandHeight = (height + bands - 1) / bands;
+
+  // count, then place the edges of each band; lines exclude their northern end
+  mBandStart.assign(bands + 1, 0);
+  for (const Edge& e : edges) {
+    const int64_t b0 = (e.y1 - mLatMin) / mBandHeight, b1 = (e.y2 - 1 - mLatMin) / mBandHeight;
+    for (int64_t b = b0; b <= b1; ++b)
+      mBandStart[b + 1] += 1;
+  }
+  for (int64_t b = 0; b < bands; ++b)
+    mBandStart[b + 1] += mBandStart[b];
+  mEdges.resize(mBandStart[bands]);
+  std::vector<uint32_t> next(mBandStart.begin(), mBandStart.end() - 1);
+  for (const Edge& e : edges) {
+    const int64_t b0 = (e.y1 - mLatMin) / mBandHeight, b1 = (e.y2 - 1 - mLatMin) / mBandHeight;
+    for (int64_t b = b0; b <= b1; ++b)
+      mEdges[next[b]++] = e;
+  }
+}
+
+bool miPreparedRegion::containsCmin(int64_t x, int64_t y) const
+{
+  if (mEdges.empty())
+    return false;
+  if (x < mLonMin || x > mLonMax || y < mLatMin || y >= mLatMax)
+    return false;
+
+  const int64_t band = (y - mLatMin) / mBandHeight;
+  bool inside = false;
+  for (uint32_t i = mBandStart[band]; i < mBandStart[band + 1]; ++i) {
+    const Edge& e = mEdges[i];
+    if (y < e.y1 || y >= e.y2)
+      continue;
+    // the ray crosses the line if the point is left of it, going north
+    const int64_t side = (int64_t(e.x2) - e.x1) * (y - e.y1) - (int64_t(e.y2) - e.y1) * (x - e.x1);
+    inside ^= (side > 0);
+  }
+  return inside;
+}
+
+bool miPreparedRegion::contains(const miCoordinates& point) const
+{
+  return containsCmin(point.Lon().totalCmin(), point.Lat().totalCmin());
+}
+
+void miPreparedRegion::contains(const miCoordinates* points, std::size_t count, char* inside) const
+{
+  if (mEdges.empty()) {
+    std::fill(inside, inside + count, 0);
+    return;
+  }
+  for (std::size_t i = 0; i < count; ++i)
+    inside[i] = containsCmin(points[i].Lon().totalCmin(), points[i].Lat().totalCmin());
+}
+
+void miPreparedRegion::contains(const std::vector<miCoordinates>& points, std::vector<char>& inside) const
+{
+  inside.resize(points.size());
+  if (!points.empty())
+    contains(points.data(), points.size(), inside.data());
+}
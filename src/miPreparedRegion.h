@@ -0,0 +1,85 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miPreparedRegion_h
+#define puDatatypes_miPreparedRegion_h
+
+#include "miRegions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*! Border of a miRegions indexed by latitude bands, for fast repeated
+ *  point-in-region tests.
+ *
+ *  The latitude range of the region is divided into about as many bands
+ *  as there are border lines, and each band lists the lines reaching
+ *  into it. A test counts the crossings of a ray going east from the
+ *  point with the lines of one band, in exact integer arithmetic on
+ *  centiminutes. No origin is needed, unlike miRegions::isInside.
+ *
+ *  Lines include their southern end but not their northern one, so a ray
+ *  through a corner is counted correctly. Points exactly on the border
+ *  may be reported either inside or outside.
+ */
+class miPreparedRegion {
+public:
+  miPreparedRegion()
+    : mLonMin(0), mLonMax(-1), mLatMin(0), mLatMax(-1), mBandHeight(1) { }
+  explicit miPreparedRegion(const miRegions& region);
+
+  bool empty() const
+    { return mEdges.empty(); }
+
+  bool contains(const miCoordinates& point) const;
+
+  //! as contains(), for a point given in centiminutes
+  bool containsCmin(int64_t lon, int64_t lat) const;
+
+  //! inside[i] is set to 1 if points[i] is inside, else 0
+  void contains(const miCoordinates* points, std::size_t count, char* inside) const;
+  void contains(const std::vector<miCoordinates>& points, std::vector<char>& inside) const;
+
+  //! number of bands
+  std::size_t bands() const
+    { return mBandStart.empty() ? 0 : mBandStart.size() - 1; }
+
+private:
+  struct Edge {
+    int32_t x1, y1; // southern end
+    int32_t x2, y2; // northern end
+  };
+
+  int64_t mLonMin, mLonMax, mLatMin, mLatMax;
+  int64_t mBandHeight;
+  std::vector<uint32_t> mBandStart; // edges of band b are mEdges[mBandStart[b] .. mBandStart[b+1])
+  std::vector<Edge> mEdges;
+};
+
+#endif // puDatatypes_miPreparedRegion_h
@@ -0,0 +1,168 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miProximity.h"
+
+#include "miCellId.h"
+#include "miParallel.h"
+#include "miPointIndex.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+struct SweepPoint {
+  double lat;
+  double xyz[3];
+  std::size_t index;
+
+  bool operator<(const SweepPoint& o) const
+    { return lat < o.lat || (lat == o.lat && index < o.index); }
+};
+
+} // namespace
+
+void findPairsWithin(const std::vector<LonLat>& points, double radius, const miPairCallback& found)
+{
+  if (radius < 0)
+    return;
+
+  std::vector<SweepPoint> sweep(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    sweep[i].lat = points[i].lat();
+    PreparedLonLat(points[i]).unitVector(sweep[i].xyz);
+    sweep[i].index = i;
+  }
+  std::sort(sweep.begin(), sweep.end());
+
+  // the great circle distance is at least the latitude difference
+  const double dlat = radius / EARTH_RADIUS_M;
+  const double c2max = chord2ForDistance(radius);
+  for (std::size_t a = 0; a < sweep.size(); ++a) {
+    const SweepPoint& pa = sweep[a];
+    for (std::size_t b = a + 1; b < sweep.size() && sweep[b].lat - pa.lat <= dlat; ++b) {
+      const SweepPoint& pb = sweep[b];
+      const double dx = pa.xyz[0] - pb.xyz[0], dy = pa.xyz[1] - pb.xyz[1], dz = pa.xyz[2] - pb.xyz[2];
+      const double c2 = dx*dx + dy*dy + dz*dz;
+      if (c2 > c2max)
+        continue;
+      const double distance = distanceForChord2(c2);
+      if (pa.index < pb.index)
+        found(pa.index, pb.index, distance);
+      else
+        found(pb.index, pa.index, distance);
+    }
+  }
+}
+
+void findNeighboursWithin(const std::vector<LonLat>& points, double radius, miAdjacency& adjacency)
+{
+  struct Pair {
+    std::size_t i, j;
+    double distance;
+  };
+  std::vector<Pair> pairs;
+  findPairsWithin(points, radius, [&pairs](std::size_t i, std::size_t j, double distance) {
+      const Pair p = { i, j, distance };
+      pairs.push_back(p);
+    });
+
+  const std::size_t n = points.size();
+  adjacency.offsets.assign(n + 1, 0);
+  for (std::size_t p = 0; p < pairs.size(); ++p) {
+    adjacency.offsets[pairs[p].i + 1] += 1;
+    adjacency.offsets[pairs[p].j + 1] += 1;
+  }
+  for (std::size_t i = 0; i < n; ++i)
+    adjacency.offsets[i + 1] += adjacency.offsets[i];
+
+  adjacency.neighbours.resize(2*pairs.size());
+  adjacency.distances.resize(2*pairs.size());
+  std::vector<std::size_t> fill(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+  for (std::size_t p = 0; p < pairs.size(); ++p) {
+    const Pair& pp = pairs[p];
+    adjacency.neighbours[fill[pp.i]] = pp.j;
+    adjacency.distances[fill[pp.i]++] = pp.distance;
+    adjacency.neighbours[fill[pp.j]] = pp.i;
+    adjacency.distances[fill[pp.j]++] = pp.distance;
+  }
+
+  // sort each row by neighbour index
+  std::vector<std::pair<std::size_t, double> > row;
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t b = adjacency.offsets[i], e = adjacency.offsets[i+1];
+    row.clear();
+    for (std::size_t k = b; k < e; ++k)
+      row.push_back(std::make_pair(adjacency.neighbours[k], adjacency.distances[k]));
+    std::sort(row.begin(), row.end());
+    for (std::size_t k = b; k < e; ++k) {
+      adjacency.neighbours[k] = row[k - b].first;
+      adjacency.distances[k] = row[k - b].second;
+    }
+  }
+}
+
+std::size_t knnJoin(const std::vector<LonLat>& queries, const std::vector<LonLat>& points, std::size_t k,
+    std::vector<std::size_t>& indices, std::vector<double>& distances, unsigned int threads)
+{
+  const std::size_t stride = std::min(k, points.size());
+  indices.resize(queries.size() * stride);
+  distances.resize(queries.size() * stride);
+  if (stride == 0 || queries.empty())
+    return stride;
+
+  const miPointIndex index(points);
+
+  std::vector<std::pair<miCellId, std::size_t> > order(queries.size());
+  for (std::size_t q = 0; q < queries.size(); ++q)
+    order[q] = std::make_pair(miCellId::fromLonLat(queries[q]), q);
+  std::sort(order.begin(), order.end());
+
+  // threads take chunks of queries in cell order until none are left
+  const std::size_t CHUNK = 64;
+  std::atomic<std::size_t> next(0);
+  const auto work = [&](unsigned int) {
+    std::vector<std::size_t> found;
+    std::vector<double> found_distances;
+    for (;;) {
+      const std::size_t begin = next.fetch_add(CHUNK);
+      if (begin >= order.size())
+        break;
+      const std::size_t end = std::min(begin + CHUNK, order.size());
+      for (std::size_t o = begin; o < end; ++o) {
+        const std::size_t q = order[o].second;
+        index.nearest(queries[q], stride, found, &found_distances);
+        std::copy(found.begin(), found.end(), indices.begin() + q*stride);
+        std::copy(found_distances.begin(), found_distances.end(), distances.begin() + q*stride);
+      }
+    }
+  };
+
+  miParallel::run(miParallel::threadCount(threads, (order.size() + CHUNK - 1) / CHUNK), work);
+  return stride;
+}
@@ -0,0 +1,86 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miProximity_h
+#define puDatatypes_miProximity_h
+
+#include "miCoordinates.h"
+
+#include <functional>
+#include <vector>
+
+/*! Adjacency lists in compressed sparse row form.
+ *
+ *  The neighbours of point i are neighbours[offsets[i]] up to
+ *  neighbours[offsets[i+1]-1], with the distances in m at the same
+ *  positions in distances.
+ */
+struct miAdjacency {
+  std::vector<std::size_t> offsets;
+  std::vector<std::size_t> neighbours;
+  std::vector<double> distances;
+
+  std::size_t size() const
+    { return offsets.empty() ? 0 : offsets.size() - 1; }
+  std::size_t count(std::size_t i) const
+    { return offsets[i+1] - offsets[i]; }
+};
+
+//! callback for pairs of point indices i < j with their distance in m
+typedef std::function<void(std::size_t i, std::size_t j, double distance)> miPairCallback;
+
+/*! find all pairs of 'points' within 'radius' m of each other
+ *
+ *  The points are swept in order of latitude, and only points within
+ *  the radius in latitude are compared, first by their squared chord
+ *  against a precomputed threshold. The distance is calculated only for
+ *  pairs within the radius. Each pair is reported once, with i < j.
+ */
+void findPairsWithin(const std::vector<LonLat>& points, double radius, const miPairCallback& found);
+
+/*! find the neighbours within 'radius' m for each of 'points'
+ *
+ *  Neighbours do not include the point itself and are sorted by index.
+ */
+void findNeighboursWithin(const std::vector<LonLat>& points, double radius, miAdjacency& adjacency);
+
+/*! k nearest neighbour join: for each of 'queries', find the 'k' nearest of 'points'
+ *
+ *  The points are indexed in a miPointIndex. Queries are processed in
+ *  miCellId order, so that neighbouring queries visit the same parts of
+ *  the index, by 'threads' threads (0 for one per hardware thread).
+ *
+ *  The results for query q are in indices and distances (in m) from
+ *  position q*stride, nearest first, where stride = min(k,
+ *  points.size()) is the return value. The results do not depend on the
+ *  number of threads.
+ */
+std::size_t knnJoin(const std::vector<LonLat>& queries, const std::vector<LonLat>& points, std::size_t k,
+    std::vector<std::size_t>& indices, std::vector<double>& distances, unsigned int threads = 0);
+
+#endif // puDatatypes_miProximity_h
@@ -0,0 +1,193 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miRegionRaster.h"
+
+#include <algorithm>
+
+namespace {
+
+using miPredicates::Point;
+
+// true if the segment a-b has a point in common with the closed rectangle
+bool touches(const Point& a, const Point& b, int64_t x0, int64_t y0, int64_t x1, int64_t y1)
+{
+  if (std::max(a.x, b.x) < x0 || std::min(a.x, b.x) > x1
+      || std::max(a.y, b.y) < y0 || std::min(a.y, b.y) > y1)
+    return false;
+  if ((x0 <= a.x && a.x <= x1 && y0 <= a.y && a.y <= y1)
+      || (x0 <= b.x && b.x <= x1 && y0 <= b.y && b.y <= y1))
+    return true;
+  const Point sw(x0, y0), se(x1, y0), ne(x1, y1), nw(x0, y1);
+  return miPredicates::segmentsIntersect(a, b, sw, se)
+      || miPredicates::segmentsIntersect(a, b, se, ne)
+      || miPredicates::segmentsIntersect(a, b, ne, nw)
+      || miPredicates::segmentsIntersect(a, b, nw, sw);
+}
+
+int64_t divCeil(int64_t a, int64_t b)
+{
+  return (a + b - 1) / b;
+}
+
+} // namespace
+
+miRegionRaster::miRegionRaster(const miRegions& region, unsigned int cells, unsigned int subcells)
+  : mPrepared(region)
+  , mLonMin(0), mLatMin(0)
+  , mCellWidth(1), mCellHeight(1)
+  , mSubWidth(1), mSubHeight(1)
+  , mNx(0), mNy(0), mSub(std::max(1u, subcells))
+{
+  const std::vector<miLine>& border = region.getBorders();
+  if (mPrepared.empty())
+    return;
+
+  int64_t lonMax = border[0].pBegin().x, latMax = border[0].pBegin().y;
+  mLonMin = lonMax;
+  mLatMin = latMax;
+  for (const miLine& l : border) {
+    const Point& p = l.pBegin();
+    mLonMin = std::min(mLonMin, p.x);
+    mLatMin = std::min(mLatMin, p.y);
+    lonMax = std::max(lonMax, p.x);
+    latMax = std::max(latMax, p.y);
+  }
+
+  // cells cover whole centiminutes, mCellWidth x mCellHeight of them
+  cells = std::max(1u, cells);
+  mCellWidth = divCeil(lonMax - mLonMin + 1, cells);
+  mCellHeight = divCeil(latMax - mLatMin + 1, cells);
+  mNx = unsigned(divCeil(lonMax - mLonMin + 1, mCellWidth));
+  mNy = unsigned(divCeil(latMax - mLatMin + 1, mCellHeight));
+  mSubWidth = divCeil(mCellWidth, mSub);
+  mSubHeight = divCeil(mCellHeight, mSub);
+
+  // (cell, line) for all grid cells touched by a line
+  std::vector<std::pair<uint32_t, uint32_t> > touched;
+  for (std::size_t e = 0; e < border.size(); ++e) {
+    const Point& a = border[e].pBegin();
+    const Point& b = border[e].pEnd();
+    const int64_t i0 = (std::min(a.x, b.x) - mLonMin) / mCellWidth, i1 = (std::max(a.x, b.x) - mLonMin) / mCellWidth;
+    const int64_t j0 = (std::min(a.y, b.y) - mLatMin) / mCellHeight, j1 = (std::max(a.y, b.y) - mLatMin) / mCellHeight;
+    for (int64_t j = j0; j <= j1; ++j) {
+      const int64_t y0 = mLatMin + j*mCellHeight, y1 = y0 + mCellHeight - 1;
+      // longitude range of the line in this row, widened by one cell for rounding
+      int64_t ri0 = i0, ri1 = i1;
+      if (a.y != b.y) {
+        const int64_t ya = std::max(y0, std::min(a.y, b.y)), yb = std::min(y1, std::max(a.y, b.y));
+        const int64_t xa = a.x + (ya - a.y) * (b.x - a.x) / (b.y - a.y);
+        const int64_t xb = a.x + (yb - a.y) * (b.x - a.x) / (b.y - a.y);
+        ri0 = std::max(i0, (std::min(xa, xb) - mLonMin) / mCellWidth - 1);
+        ri1 = std::min(i1, (std::max(xa, xb) - mLonMin) / mCellWidth + 1);
+      }
+      for (int64_t i = ri0; i <= ri1; ++i) {
+        const int64_t x0 = mLonMin + i*mCellWidth;
+        if (touches(a, b, x0, y0, x0 + mCellWidth - 1, y1))
+          touched.push_back(std::make_pair(uint32_t(j*mNx + i), uint32_t(e)));
+      }
+    }
+  }
+  std::sort(touched.begin(), touched.end());
+
+  mCells.assign(std::size_t(mNx) * mNy, OUTSIDE);
+  std::size_t t = 0;
+  for (uint32_t c = 0; c < mCells.size(); ++c) {
+    const int64_t x0 = mLonMin + (c % mNx)*mCellWidth, y0 = mLatMin + (c / mNx)*mCellHeight;
+    if (t == touched.size() || touched[t].first != c) {
+      // no line in the cell, so all of it is on the same side
+      mCells[c] = mPrepared.containsCmin(x0, y0) ? INSIDE : OUTSIDE;
+      continue;
+    }
+
+    const std::size_t begin = t;
+    while (t < touched.size() && touched[t].first == c)
+      t += 1;
+    mCells[c] = BORDER + uint32_t(mSubcells.size());
+    for (unsigned int sj = 0; sj < mSub; ++sj) {
+      const int64_t sy0 = y0 + sj*mSubHeight, sy1 = std::min(sy0 + mSubHeight, y0 + mCellHeight) - 1;
+      for (unsigned int si = 0; si < mSub; ++si) {
+        const int64_t sx0 = x0 + si*mSubWidth, sx1 = std::min(sx0 + mSubWidth, x0 + mCellWidth) - 1;
+        uint8_t s = BORDER;
+        if (sx0 <= sx1 && sy0 <= sy1) {
+          bool line = false;
+          for (std::size_t k = begin; k < t && !line; ++k) {
+            const miLine& l = border[touched[k].second];
+            line = touches(l.pBegin(), l.pEnd(), sx0, sy0, sx1, sy1);
+          }
+          if (!line)
+            s = mPrepared.containsCmin(sx0, sy0) ? INSIDE : OUTSIDE;
+        }
+        mSubcells.push_back(s);
+      }
+    }
+  }
+}
+
+bool miRegionRaster::contains(int64_t x, int64_t y, Stats* stats) const
+{
+  if (mCells.empty() || x < mLonMin || y < mLatMin
+      || x >= mLonMin + mNx*mCellWidth || y >= mLatMin + mNy*mCellHeight) {
+    if (stats)
+      stats->cellHits += 1;
+    return false;
+  }
+
+  const int64_t i = (x - mLonMin) / mCellWidth, j = (y - mLatMin) / mCellHeight;
+  const uint32_t cell = mCells[j*mNx + i];
+  if (cell < BORDER) {
+    if (stats)
+      stats->cellHits += 1;
+    return cell == INSIDE;
+  }
+
+  const int64_t si = (x - mLonMin - i*mCellWidth) / mSubWidth, sj = (y - mLatMin - j*mCellHeight) / mSubHeight;
+  const uint8_t sub = mSubcells[cell - BORDER + sj*mSub + si];
+  if (sub < BORDER) {
+    if (stats)
+      stats->subcellHits += 1;
+    return sub == INSIDE;
+  }
+
+  if (stats)
+    stats->exact += 1;
+  return mPrepared.containsCmin(x, y);
+}
+
+bool miRegionRaster::contains(const miCoordinates& point, Stats* stats) const
+{
+  return contains(point.Lon().totalCmin(), point.Lat().totalCmin(), stats);
+}
+
+void miRegionRaster::contains(const std::vector<miCoordinates>& points, std::vector<char>& inside,
+    Stats* stats) const
+{
+  inside.resize(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    inside[i] = contains(points[i].Lon().totalCmin(), points[i].Lat().totalCmin(), stats);
+}
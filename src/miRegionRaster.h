@@ -0,0 +1,108 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miRegionRaster_h
+#define puDatatypes_miRegionRaster_h
+
+#include "miPreparedRegion.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*! Two level grid over a miRegions, classifying cells as inside, outside
+ *  or on the border, for fast point-in-region tests.
+ *
+ *  The bounding box of the region is divided into at most cells x cells
+ *  grid cells. Cells touched by a border line are divided again into
+ *  subcells x subcells, and only points in subcells touched by a border
+ *  line are tested exactly with miPreparedRegion. The results are always
+ *  those of miPreparedRegion::contains.
+ *
+ *  Memory is 4 bytes per grid cell and 'subcells' squared bytes per
+ *  border cell; see memoryUsage().
+ */
+class miRegionRaster {
+public:
+  //! counts of how queries were answered
+  struct Stats {
+    std::size_t cellHits;    //!< by the grid cell alone, including points outside the bounding box
+    std::size_t subcellHits; //!< by a subcell
+    std::size_t exact;       //!< by the exact test
+
+    Stats()
+      : cellHits(0), subcellHits(0), exact(0) { }
+    std::size_t queries() const
+      { return cellHits + subcellHits + exact; }
+    //! fraction of queries answered without the exact test
+    double hitRate() const
+      { return queries() ? double(cellHits + subcellHits) / queries() : 0; }
+  };
+
+  miRegionRaster()
+    : mLonMin(0), mLatMin(0), mCellWidth(1), mCellHeight(1), mSubWidth(1), mSubHeight(1)
+    , mNx(0), mNy(0), mSub(1) { }
+  explicit miRegionRaster(const miRegions& region, unsigned int cells = 256, unsigned int subcells = 8);
+
+  //! if 'stats' is given, the query is counted there
+  bool contains(const miCoordinates& point, Stats* stats = 0) const;
+
+  //! inside[i] is set to 1 if points[i] is inside, else 0
+  void contains(const std::vector<miCoordinates>& points, std::vector<char>& inside, Stats* stats = 0) const;
+
+  const miPreparedRegion& prepared() const
+    { return mPrepared; }
+
+  //! number of grid cells touched by the border
+  std::size_t borderCells() const
+    { return mSubcells.size() / (mSub*mSub); }
+
+  //! approximate memory used by the grids, in bytes
+  std::size_t memoryUsage() const
+    { return mCells.size() * sizeof(uint32_t) + mSubcells.size(); }
+
+private:
+  enum { OUTSIDE = 0, INSIDE = 1, BORDER = 2 };
+
+  bool contains(int64_t x, int64_t y, Stats* stats) const;
+
+private:
+  miPreparedRegion mPrepared;
+
+  int64_t mLonMin, mLatMin;
+  int64_t mCellWidth, mCellHeight;
+  int64_t mSubWidth, mSubHeight;
+  unsigned int mNx, mNy, mSub;
+
+  // OUTSIDE, INSIDE, or BORDER + index of the first subcell
+  std::vector<uint32_t> mCells;
+  // OUTSIDE, INSIDE or BORDER, subcells of the border cells
+  std::vector<uint8_t> mSubcells;
+};
+
+#endif // puDatatypes_miRegionRaster_h
@@ -29,6 +29,9 @@
 
 #include "miRegions.h"
 
+#include "miSegmentSweep.h"
+
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <list>
@@ -104,7 +107,7 @@ void miRegions::clear()
 {
   corner.clear();
   border.clear();
-  cornerset.clear();
+  cornerkeys.clear();
   name_ = "";
   idn   = 0;
   area_ = 0;
@@ -121,9 +124,11 @@ void miRegions::addCorner(int lon,int lat)
 
 void miRegions::addCorner(miCoordinates mc)
 {
-  if(cornerset.count(mc))
+  const uint64_t key = mc.key();
+  vector<uint64_t>::iterator it = lower_bound(cornerkeys.begin(), cornerkeys.end(), key);
+  if(it != cornerkeys.end() && *it == key)
     return;
-  cornerset.insert(mc);
+  cornerkeys.insert(it, key);
   corner.push_back(mc);
   setBorders();
 }
@@ -131,16 +136,33 @@ void miRegions::addCorner(miCoordinates mc)
 
 void miRegions::setCorners(const vector<miCoordinates> &c )
 {
-  cornerset.clear();
-  corner.clear();
+  setUniqueCorners(c);
+  setBorders();
+}
 
-  for(size_t i=0;i<c.size();i++) {
-    if(cornerset.count(c[i]))
+
+/// copy the corners, skipping repeated coordinates
+void miRegions::setUniqueCorners(const vector<miCoordinates> &c )
+{
+  vector< pair<uint64_t, size_t> > keyed(c.size());
+  for(size_t i=0;i<c.size();i++)
+    keyed[i] = make_pair(c[i].key(), i);
+  sort(keyed.begin(), keyed.end());
+
+  // keep the first occurrence of each key
+  vector<char> keep(c.size(), 0);
+  cornerkeys.clear();
+  for(size_t i=0;i<keyed.size();i++) {
+    if(i>0 && keyed[i].first == keyed[i-1].first)
       continue;
-    cornerset.insert(c[i]);
-    corner.push_back(c[i]);
+    keep[keyed[i].second] = 1;
+    cornerkeys.push_back(keyed[i].first);
   }
-  setBorders();
+
+  corner.clear();
+  for(size_t i=0;i<c.size();i++)
+    if(keep[i])
+      corner.push_back(c[i]);
 }
 
 
@@ -224,12 +246,30 @@ bool miRegions::isInside( const miCoordinates & seek_pt ) const
 int miRegions::no_of_crosses(const miLine& target) const
 {
   int count = 0;
+  if (exact_) {
+    for (size_t i = 0; i < border.size(); i++ )
+      if ( miPredicates::crossesEdge( target.pBegin(), target.pEnd(),
+                                      border[i].pBegin(), border[i].pEnd() ) )
+        count++;
+    return count;
+  }
   for (size_t i = 0; i < border.size(); i++ )
     if ( border[i].cross( target ) )
       count++;
   return count;
 }
 
+bool miRegions::isSimple() const
+{
+  return !miSegmentSweep(border, miSegmentSweep::IGNORE_SHARED_ENDPOINTS).anyIntersection();
+}
+
+
+vector< pair<size_t, size_t> > miRegions::borderCrossings(const miRegions& rhs) const
+{
+  return miSegmentSweep(border, rhs.border).intersections();
+}
+
 vector<miRegions> miRegions::triangles()
 {
   if(!triangles_.empty())
@@ -244,6 +284,7 @@ vector<miRegions> miRegions::triangles()
     return triangles_;
 
   miRegions tmp;
+  tmp.setExactPredicates(exact_);
   int curr=0,next,prev;
 
   while(!tcorners.empty()) {
@@ -362,6 +403,7 @@ miRegions miRegions::subregion(float c,std::string sector, bool& inside,int rnd)
   subreg.setPriority( priority_ );
   subreg.setName(     name_     );
   subreg.setOrigin(   orig      );
+  subreg.setExactPredicates( exact_ );
   subreg.setCorners(  sub       );
 
   return subreg;
@@ -671,7 +713,7 @@ bool miRegions::join(miRegions lhs,miRegions rhs,int tolerance)
       res.push_back(secondc[s]);
 
   vector<miCoordinates> oldcorners    = corner;
-  set<miCoordinates>    oldcornerset  = cornerset;
+  vector<uint64_t>      oldcornerkeys = cornerkeys;
   vector<miRegions>     oldtriangles  = triangles_;
 
   // when  you join 2 regions with at least 3 corners
@@ -683,25 +725,15 @@ bool miRegions::join(miRegions lhs,miRegions rhs,int tolerance)
     return false;
   }
 
-  list<miCoordinates>::iterator itr=res.begin();
-
   triangles_.clear();
-  corner.clear();
   setOrigin(lhs.origo());
 
-  cornerset.clear();
-
-  for(;itr!=res.end();itr++) {
-    if(cornerset.count(*itr))
-      continue;
-    cornerset.insert(*itr);
-    corner.push_back(*itr);
-  }
+  setUniqueCorners(vector<miCoordinates>(res.begin(), res.end()));
 
   if(corner.size() < 4) {
     if(debugmode) cerr << "false / size < 4 after" << endl;
-    cornerset = oldcornerset;
-    corner    = oldcorners;
+    cornerkeys = oldcornerkeys;
+    corner     = oldcorners;
     return false;
   }
 
@@ -810,22 +842,16 @@ bool miRegions::isInside( const miRegions& lhs, int threshold) const
 
 bool miRegions::cornerCompare( vector<miCoordinates> c) const
 {
-  set<miCoordinates> s;
-
   if(c.size() != corner.size() )
     return false;
 
+  // corners are unique, so the sorted keys must be identical
+  vector<uint64_t> keys(c.size());
   for (size_t i=0; i<c.size(); i++)
-    s.insert(c[i]);
-
-  if(s.size() != corner.size() )
-    return false;
+    keys[i] = c[i].key();
+  sort(keys.begin(), keys.end());
 
-  for (size_t i=0; i<corner.size(); i++)
-    if(!s.count(corner[i]))
-      return false;
-
-  return true;
+  return keys == cornerkeys;
 }
 
 
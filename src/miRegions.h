@@ -32,8 +32,8 @@
 #include "miLine.h"
 
 #include <vector>
-#include <set>
 #include <string>
+#include <utility>
 
 /// class containing a region withy corners name etc.
 /** The object can be compared to other regions and has functionallity to:
@@ -75,11 +75,12 @@ private:
   std::vector<miLine> border;
   std::string name_;
   int idn;
-  std::set<miCoordinates> cornerset;
+  std::vector<uint64_t> cornerkeys; // sorted miCoordinates::key() of all corners
 
   miCoordinates orig;
   int priority_;
   int area_; // km2
+  bool exact_; // use miPredicates instead of miLine::cross
 
   std::vector<miRegions> triangles_;
 
@@ -88,21 +89,24 @@ private:
   miCoordinates center_;
 
   void setBorders();
+  void setUniqueCorners(const std::vector<miCoordinates>& c);
   bool
       isPartOfSubregion(const miLine&, const miCoordinates&, const std::string&) const;
   bool cornerCompare(std::vector<miCoordinates> c) const;
 
 public:
-  miRegions()
+  miRegions() :
+    exact_(false)
   {
   }
   /// create an empty region with a name, but without coordinates
   miRegions(std::string name, int id) :
-    name_(name), idn(id)
+    name_(name), idn(id), exact_(false)
   {
   }
   /// create a region by joining to others
-  miRegions(miRegions lhs, miRegions rhs, int tolerance = 1)
+  miRegions(miRegions lhs, miRegions rhs, int tolerance = 1) :
+    exact_(false)
   {
     join(lhs, rhs, tolerance);
   }
@@ -134,6 +138,19 @@ public:
   {
     orig = o;
   }
+  /// count border crossings with exact integer tests in centiminutes
+  /** Without this, isInside and subregion use miLine::cross with its
+   *  float tolerance. With it, a line through a corner is counted
+   *  consistently, and points close to the border are never misjudged.
+   */
+  void setExactPredicates(bool exact)
+  {
+    exact_ = exact;
+  }
+  bool exactPredicates() const
+  {
+    return exact_;
+  }
   void setCorners(const std::vector<miCoordinates> &c);
 
   /// set a new corner
@@ -152,6 +169,11 @@ public:
   {
     return corner;
   }
+  /// the closed border, one line per edge
+  const std::vector<miLine>& getBorders() const
+  {
+    return border;
+  }
   std::vector<miRegions> triangles();
 
   const std::string& regName() const
@@ -212,6 +234,11 @@ public:
   miRegions
       subregion(float c, std::string sector, bool& ok, int rnd = 0) const; //sector=N|S|W|E
 
+  /// true if no two border lines cross or touch, except neighbours at their common corner
+  bool isSimple() const;
+  /// pairs of indices into getBorders() of this and of rhs for crossing or touching lines
+  std::vector<std::pair<size_t, size_t> > borderCrossings(const miRegions& rhs) const;
+
   bool isCounterClockwise();
   void turnCounterClockwise();
   bool isConvex();
@@ -0,0 +1,258 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miSegmentSweep.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <set>
+
+namespace {
+
+// true if segments a-b and c-d have only a common end point in common
+bool onlySharedEndpoint(const miPredicates::Point& a, const miPredicates::Point& b,
+    const miPredicates::Point& c, const miPredicates::Point& d)
+{
+  miPredicates::Point shared, u, v; // u and v are the other ends
+  if (a == c) {
+    shared = a; u = b; v = d;
+  } else if (a == d) {
+    shared = a; u = b; v = c;
+  } else if (b == c) {
+    shared = b; u = a; v = d;
+  } else if (b == d) {
+    shared = b; u = a; v = c;
+  } else {
+    return false;
+  }
+  // collinear lines continuing in the same direction overlap
+  if (miPredicates::orientation(shared, u, v) != 0)
+    return true;
+  return (u.x - shared.x) * (v.x - shared.x) + (u.y - shared.y) * (v.y - shared.y) < 0;
+}
+
+} // namespace
+
+/*
+  Active segments of one set, with an expiry queue on the eastern end.
+
+  Segments overlapping a latitude range [y0, y1] either contain y0 or
+  start north of y0 and not north of y1. The first kind is found by
+  walking a segment tree over the latitudes from the leaf of y0 to the
+  root, the second kind in a set ordered by the southern end. Removed
+  segments are dropped lazily from the segment tree.
+*/
+class miSegmentSweep::Active {
+public:
+  Active(const std::vector<Segment>& segments, std::size_t latitudes)
+    : mSegments(segments)
+    , mLeaves(1)
+    , mAlive(segments.size(), 0)
+  {
+    while (mLeaves < latitudes)
+      mLeaves *= 2;
+    mNodes.resize(2*mLeaves);
+  }
+
+  void insert(uint32_t s)
+  {
+    const Segment& seg = mSegments[s];
+    mAlive[s] = 1;
+    for (std::size_t l = seg.ylo + mLeaves, r = seg.yhi + mLeaves + 1; l < r; l /= 2, r /= 2) {
+      if (l & 1)
+        mNodes[l++].push_back(s);
+      if (r & 1)
+        mNodes[--r].push_back(s);
+    }
+    mByYmin.insert(std::make_pair(seg.ymin, s));
+    mExpiry.push(std::make_pair(seg.xmax, s));
+  }
+
+  //! remove segments ending west of x
+  void expire(int64_t x)
+  {
+    while (!mExpiry.empty() && mExpiry.top().first < x) {
+      const uint32_t s = mExpiry.top().second;
+      mExpiry.pop();
+      mAlive[s] = 0;
+      mByYmin.erase(std::make_pair(mSegments[s].ymin, s));
+    }
+  }
+
+  //! call found(s) for active segments overlapping 'seg' in latitude until it returns false
+  template<class F>
+  bool overlapping(const Segment& seg, const F& found)
+  {
+    for (std::size_t n = seg.ylo + mLeaves; n >= 1; n /= 2) {
+      std::vector<uint32_t>& node = mNodes[n];
+      for (std::size_t i = 0; i < node.size(); ) {
+        if (!mAlive[node[i]]) {
+          node[i] = node.back();
+          node.pop_back();
+          continue;
+        }
+        if (!found(node[i]))
+          return false;
+        i += 1;
+      }
+    }
+    typedef std::set<std::pair<int64_t, uint32_t> >::const_iterator iterator;
+    const iterator end = mByYmin.upper_bound(std::make_pair(seg.ymax, UINT32_MAX));
+    for (iterator it = mByYmin.upper_bound(std::make_pair(seg.ymin, UINT32_MAX)); it != end; ++it)
+      if (!found(it->second))
+        return false;
+    return true;
+  }
+
+private:
+  const std::vector<Segment>& mSegments;
+  std::size_t mLeaves;
+  std::vector<std::vector<uint32_t> > mNodes;
+  std::set<std::pair<int64_t, uint32_t> > mByYmin;
+  std::priority_queue<std::pair<int64_t, uint32_t>, std::vector<std::pair<int64_t, uint32_t> >,
+      std::greater<std::pair<int64_t, uint32_t> > > mExpiry;
+  std::vector<char> mAlive;
+};
+
+miSegmentSweep::miSegmentSweep(const std::vector<miLine>& lines, Touching touching)
+  : mLatitudes(0)
+  , mTwoSets(false)
+  , mTouching(touching)
+{
+  add(lines, 0);
+  prepare();
+}
+
+miSegmentSweep::miSegmentSweep(const std::vector<miLine>& first, const std::vector<miLine>& second,
+    Touching touching)
+  : mLatitudes(0)
+  , mTwoSets(true)
+  , mTouching(touching)
+{
+  add(first, 0);
+  add(second, 1);
+  prepare();
+}
+
+void miSegmentSweep::add(const std::vector<miLine>& lines, int set)
+{
+  mSegments.reserve(mSegments.size() + lines.size());
+  for (std::size_t i = 0; i < lines.size(); ++i) {
+    Segment s;
+    s.p1 = lines[i].pBegin();
+    s.p2 = lines[i].pEnd();
+    s.xmin = std::min(s.p1.x, s.p2.x);
+    s.xmax = std::max(s.p1.x, s.p2.x);
+    s.ymin = std::min(s.p1.y, s.p2.y);
+    s.ymax = std::max(s.p1.y, s.p2.y);
+    s.ylo = s.yhi = 0;
+    s.index = i;
+    s.set = set;
+    mSegments.push_back(s);
+  }
+}
+
+void miSegmentSweep::prepare()
+{
+  std::sort(mSegments.begin(), mSegments.end(), [](const Segment& a, const Segment& b) {
+      if (a.xmin != b.xmin)
+        return a.xmin < b.xmin;
+      if (a.set != b.set)
+        return a.set < b.set;
+      return a.index < b.index;
+    });
+
+  std::vector<int64_t> latitudes;
+  latitudes.reserve(2*mSegments.size());
+  for (const Segment& s : mSegments) {
+    latitudes.push_back(s.ymin);
+    latitudes.push_back(s.ymax);
+  }
+  std::sort(latitudes.begin(), latitudes.end());
+  latitudes.erase(std::unique(latitudes.begin(), latitudes.end()), latitudes.end());
+  for (Segment& s : mSegments) {
+    s.ylo = uint32_t(std::lower_bound(latitudes.begin(), latitudes.end(), s.ymin) - latitudes.begin());
+    s.yhi = uint32_t(std::lower_bound(latitudes.begin(), latitudes.end(), s.ymax) - latitudes.begin());
+  }
+  mLatitudes = latitudes.size();
+}
+
+bool miSegmentSweep::intersect(const Segment& a, const Segment& b) const
+{
+  if (!miPredicates::segmentsIntersect(a.p1, a.p2, b.p1, b.p2))
+    return false;
+  return mTouching == REPORT_TOUCHING || !onlySharedEndpoint(a.p1, a.p2, b.p1, b.p2);
+}
+
+template<class F>
+void miSegmentSweep::sweep(const F& found) const
+{
+  Active first(mSegments, mLatitudes), second(mSegments, mLatitudes);
+  for (std::size_t i = 0; i < mSegments.size(); ++i) {
+    const Segment& s = mSegments[i];
+
+    // with two sets, compare only with the other set
+    Active& other = (mTwoSets && s.set == 0) ? second : first;
+    other.expire(s.xmin);
+    const bool more = other.overlapping(s, [&](uint32_t a) {
+        const Segment& o = mSegments[a];
+        if (!intersect(o, s))
+          return true;
+        const Pair p = mTwoSets
+            ? (o.set == 0 ? Pair(o.index, s.index) : Pair(s.index, o.index))
+            : Pair(std::min(o.index, s.index), std::max(o.index, s.index));
+        return found(p);
+      });
+    if (!more)
+      return;
+    ((mTwoSets && s.set == 1) ? second : first).insert(uint32_t(i));
+  }
+}
+
+std::vector<miSegmentSweep::Pair> miSegmentSweep::intersections() const
+{
+  std::vector<Pair> pairs;
+  sweep([&pairs](const Pair& p) { pairs.push_back(p); return true; });
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+bool miSegmentSweep::anyIntersection() const
+{
+  Pair pair;
+  return anyIntersection(pair);
+}
+
+bool miSegmentSweep::anyIntersection(Pair& pair) const
+{
+  bool any = false;
+  sweep([&pair, &any](const Pair& p) { pair = p; any = true; return false; });
+  return any;
+}
@@ -0,0 +1,104 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miSegmentSweep_h
+#define puDatatypes_miSegmentSweep_h
+
+#include "miLine.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*! Finds intersecting pairs among miLine segments with a sweep in longitude.
+ *
+ *  Segments are sorted by their western end. The sweep keeps the
+ *  segments whose longitude range covers the current position, indexed
+ *  by latitude range in a segment tree and an ordered set. A new
+ *  segment is thus compared only with the active segments whose
+ *  bounding box overlaps its own, and each such pair is tested exactly
+ *  with miPredicates::segmentsIntersect.
+ *
+ *  The cost is O((n + b) log n) for n segments and b pairs with
+ *  overlapping bounding boxes. This is not Bentley-Ottmann: b may be
+ *  larger than the number of crossings, up to O(n^2) for many long lines
+ *  running diagonally past each other. For region borders, where most
+ *  lines are short, b is close to the number of neighbouring lines.
+ *
+ *  With one set of lines, pairs (i, j) have i < j. With two sets, only
+ *  pairs with i from the first set and j from the second are reported.
+ */
+class miSegmentSweep {
+public:
+  typedef std::pair<std::size_t, std::size_t> Pair;
+
+  enum Touching {
+    REPORT_TOUCHING, //!< report every pair of lines with a point in common
+    IGNORE_SHARED_ENDPOINTS //!< except lines meeting only at a common end point, as neighbour edges in a border
+  };
+
+  explicit miSegmentSweep(const std::vector<miLine>& lines, Touching touching = REPORT_TOUCHING);
+  miSegmentSweep(const std::vector<miLine>& first, const std::vector<miLine>& second,
+      Touching touching = REPORT_TOUCHING);
+
+  //! all intersecting pairs, sorted
+  std::vector<Pair> intersections() const;
+
+  //! true if any pair intersects; stops at the first one found
+  bool anyIntersection() const;
+
+  //! first intersecting pair found, if any
+  bool anyIntersection(Pair& pair) const;
+
+private:
+  struct Segment {
+    miPredicates::Point p1, p2;
+    int64_t xmin, xmax, ymin, ymax;
+    uint32_t ylo, yhi; // ymin and ymax as indices into the sorted latitudes
+    std::size_t index;
+    int set;
+  };
+
+  class Active;
+
+  void add(const std::vector<miLine>& lines, int set);
+  void prepare();
+  bool intersect(const Segment& a, const Segment& b) const;
+
+  // calls found(pair) for each intersecting pair until it returns false
+  template<class F>
+  void sweep(const F& found) const;
+
+private:
+  std::vector<Segment> mSegments; // sorted by western end
+  std::size_t mLatitudes; // number of distinct ymin and ymax
+  bool mTwoSets;
+  Touching mTouching;
+};
+
+#endif // puDatatypes_miSegmentSweep_h
@@ -0,0 +1,538 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miStationCatalog.h"
+
+#include "miCellId.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+const std::size_t miStationCatalog::NONE;
+
+namespace {
+
+const char MAGIC[8] = { 'P', 'U', 'S', 'T', 'C', 'A', 'T', 0 };
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// sections in file order
+enum SectionKind {
+  LON = 1, LAT, SYNOP, DBKEY, HEIGHT, PRIORITY,
+  NAME, GROUP, ICAO, STRING_OFFSETS, STRING_CHARS,
+  UNIT_VECTORS, SYNOP_ORDER, DBKEY_ORDER, NAME_ORDER, ICAO_ORDER,
+  CELL_IDS, CELL_ORDER,
+  SECTION_COUNT = CELL_ORDER
+};
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint64_t fileSize;
+  uint32_t count;
+  uint32_t strings;
+  uint32_t sections;
+  uint32_t reserved;
+};
+
+struct Section {
+  uint32_t kind;
+  uint32_t reserved;
+  uint64_t offset;
+  uint64_t size;
+};
+
+const std::size_t ALIGN = 8;
+
+inline std::size_t aligned(std::size_t offset)
+{
+  return (offset + ALIGN - 1) & ~(ALIGN - 1);
+}
+
+// rows sorted by key, ties by row
+template<class Less>
+std::vector<uint32_t> sortedRows(std::size_t count, const Less& less)
+{
+  std::vector<uint32_t> rows(count);
+  std::iota(rows.begin(), rows.end(), 0);
+  std::stable_sort(rows.begin(), rows.end(), less);
+  return rows;
+}
+
+class Writer {
+public:
+  Writer()
+    : mData(SECTION_COUNT) { }
+
+  template<class T>
+  void add(SectionKind kind, const T* data, std::size_t count)
+    {
+      mData[kind - 1].assign(reinterpret_cast<const char*>(data), count * sizeof(T));
+    }
+
+  bool write(const std::string& filename, uint32_t count, uint32_t strings, std::string* error);
+
+private:
+  std::vector<std::string> mData;
+};
+
+bool Writer::write(const std::string& filename, uint32_t count, uint32_t strings, std::string* error)
+{
+  Header header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = miStationCatalog::VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.count = count;
+  header.strings = strings;
+  header.sections = SECTION_COUNT;
+  header.reserved = 0;
+
+  std::vector<Section> sections(SECTION_COUNT);
+  std::size_t offset = aligned(sizeof(Header) + SECTION_COUNT * sizeof(Section));
+  for (std::size_t i = 0; i < sections.size(); ++i) {
+    sections[i].kind = uint32_t(i + 1);
+    sections[i].reserved = 0;
+    sections[i].offset = offset;
+    sections[i].size = mData[i].size();
+    offset = aligned(offset + mData[i].size());
+  }
+  header.fileSize = offset;
+
+  std::string file(offset, '\0');
+  std::memcpy(&file[0], &header, sizeof(header));
+  std::memcpy(&file[sizeof(header)], sections.data(), sections.size() * sizeof(Section));
+  for (std::size_t i = 0; i < sections.size(); ++i)
+    std::copy(mData[i].begin(), mData[i].end(), file.begin() + sections[i].offset);
+
+  // write to a new temporary file next to the catalog, sync it and
+  // rename it, so that readers never see a partial catalog, not even
+  // after a crash; open applies the umask to the mode, unlike mkstemp
+  static std::atomic<unsigned int> serial(0);
+  std::string tmp;
+  int fd = -1;
+  for (int attempt = 0; fd < 0 && attempt < 100; ++attempt) {
+    tmp = filename + "." + std::to_string(::getpid()) + "." + std::to_string(serial++);
+    fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+    if (fd < 0 && errno != EEXIST)
+      break;
+  }
+  if (fd < 0) {
+    if (error)
+      *error = "cannot create a temporary file for '" + filename + "'";
+    return false;
+  }
+  bool written = true;
+  for (std::size_t done = 0; written && done < file.size(); ) {
+    const ssize_t n = ::write(fd, file.data() + done, file.size() - done);
+    if (n < 0 && errno == EINTR)
+      continue;
+    written = (n > 0);
+    if (written)
+      done += n;
+  }
+  written = written && ::fsync(fd) == 0;
+  if (::close(fd) != 0 || !written) {
+    ::unlink(tmp.c_str());
+    if (error)
+      *error = "cannot write '" + tmp + "'";
+    return false;
+  }
+  if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+    ::unlink(tmp.c_str());
+    if (error)
+      *error = "cannot rename '" + tmp + "' to '" + filename + "'";
+    return false;
+  }
+
+  // make the rename durable; if this fails, the new catalog is already
+  // in place, but the old one may be back after a crash
+  const std::string::size_type slash = filename.rfind('/');
+  const std::string dir = (slash == std::string::npos) ? "." : filename.substr(0, slash + 1);
+  const int dfd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+  if (dfd < 0 || ::fsync(dfd) != 0) {
+    if (dfd >= 0)
+      ::close(dfd);
+    if (error)
+      *error = "'" + filename + "' was replaced, but directory '" + dir + "' could not be synced";
+    return false;
+  }
+  ::close(dfd);
+  return true;
+}
+
+template<class T>
+bool isSortedBy(const uint32_t* rows, std::size_t count, std::size_t maxRow, const T& compare)
+{
+  for (std::size_t k = 0; k < count; ++k) {
+    if (rows[k] >= maxRow)
+      return false;
+    // strictly increasing (key, row), so each row appears once
+    if (k > 0) {
+      const int c = compare(rows[k-1], rows[k]);
+      if (c > 0 || (c == 0 && rows[k-1] >= rows[k]))
+        return false;
+    }
+  }
+  return true;
+}
+
+inline int compareInts(int a, int b)
+{
+  return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+} // namespace
+
+miStationCatalog::miStationCatalog()
+{
+  close();
+}
+
+bool miStationCatalog::write(const std::string& filename, const miPositionTable& table, std::string* error)
+{
+  const std::size_t n = table.size();
+  const miStringPool& strings = table.strings();
+  if (n >= ~uint32_t(0) || strings.chars() >= ~uint32_t(0)) {
+    if (error)
+      *error = "too many stations or strings";
+    return false;
+  }
+
+  Writer w;
+  w.add(LON, table.lonCmin(), n);
+  w.add(LAT, table.latCmin(), n);
+  w.add(SYNOP, table.synops(), n);
+  w.add(DBKEY, table.dbKeys(), n);
+  w.add(HEIGHT, table.heights(), n);
+  w.add(PRIORITY, table.priorities(), n);
+  w.add(NAME, table.nameIds(), n);
+  w.add(GROUP, table.groupIds(), n);
+  w.add(ICAO, table.icaoIds(), n);
+
+  std::vector<uint32_t> offsets(1, 0);
+  std::string chars;
+  for (std::size_t i = 0; i < strings.size(); ++i) {
+    chars += strings.str(miStringPool::id_t(i));
+    offsets.push_back(uint32_t(chars.size()));
+  }
+  w.add(STRING_OFFSETS, offsets.data(), offsets.size());
+  w.add(STRING_CHARS, chars.data(), chars.size());
+
+  std::vector<double> xyz(3*n);
+  for (std::size_t i = 0; i < n; ++i)
+    PreparedLonLat(table.coordinates(i).lonLat()).unitVector(&xyz[3*i]);
+  w.add(UNIT_VECTORS, xyz.data(), xyz.size());
+
+  const int* synops = table.synops();
+  const int* dbKeys = table.dbKeys();
+  const miStringPool::id_t* names = table.nameIds();
+  const miStringPool::id_t* icaos = table.icaoIds();
+  const std::vector<uint32_t> synopOrder = sortedRows(n,
+      [&](uint32_t a, uint32_t b) { return synops[a] < synops[b]; });
+  w.add(SYNOP_ORDER, synopOrder.data(), n);
+  const std::vector<uint32_t> dbKeyOrder = sortedRows(n,
+      [&](uint32_t a, uint32_t b) { return dbKeys[a] < dbKeys[b]; });
+  w.add(DBKEY_ORDER, dbKeyOrder.data(), n);
+  const std::vector<uint32_t> nameOrder = sortedRows(n,
+      [&](uint32_t a, uint32_t b) { return strings.str(names[a]) < strings.str(names[b]); });
+  w.add(NAME_ORDER, nameOrder.data(), n);
+  std::vector<uint32_t> icaoOrder = sortedRows(n,
+      [&](uint32_t a, uint32_t b) { return strings.str(icaos[a]) < strings.str(icaos[b]); });
+  icaoOrder.erase(std::remove_if(icaoOrder.begin(), icaoOrder.end(),
+          [&](uint32_t r) { return strings.str(icaos[r]).empty(); }), icaoOrder.end());
+  w.add(ICAO_ORDER, icaoOrder.data(), icaoOrder.size());
+
+  std::vector<uint64_t> cells(n);
+  for (std::size_t i = 0; i < n; ++i)
+    cells[i] = miCellId::fromCoordinates(table.coordinates(i)).id();
+  const std::vector<uint32_t> cellOrder = sortedRows(n,
+      [&](uint32_t a, uint32_t b) { return cells[a] < cells[b]; });
+  std::vector<uint64_t> sortedCells(n);
+  for (std::size_t k = 0; k < n; ++k)
+    sortedCells[k] = cells[cellOrder[k]];
+  w.add(CELL_IDS, sortedCells.data(), n);
+  w.add(CELL_ORDER, cellOrder.data(), n);
+
+  return w.write(filename, uint32_t(n), uint32_t(strings.size()), error);
+}
+
+void miStationCatalog::close()
+{
+  mFile.close();
+  mCount = mStrings = mIcaoCount = 0;
+  mLon = mLat = mSynop = mDbKey = mHeight = mPriority = 0;
+  mName = mGroup = mIcao = mStringOffsets = 0;
+  mChars = 0;
+  mUnitVectors = 0;
+  mSynopOrder = mDbKeyOrder = mNameOrder = mIcaoOrder = mCellOrder = 0;
+  mCellIds = 0;
+}
+
+bool miStationCatalog::fail(const std::string& error)
+{
+  close();
+  mError = error;
+  return false;
+}
+
+bool miStationCatalog::open(const std::string& filename)
+{
+  close();
+  mError.clear();
+  if (!mFile.open(filename))
+    return fail("cannot map '" + filename + "'");
+  return validate();
+}
+
+bool miStationCatalog::validate()
+{
+  const char* const data = mFile.data();
+  const std::size_t fileSize = mFile.size();
+
+  Header header;
+  if (fileSize < sizeof(header))
+    return fail("file too short");
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    return fail("not a station catalog");
+  if (header.byteOrder != BYTE_ORDER_MARK)
+    return fail("wrong byte order");
+  if (header.version != VERSION)
+    return fail("unsupported version " + std::to_string(header.version));
+  if (header.fileSize != fileSize)
+    return fail("truncated file");
+  if (header.sections != SECTION_COUNT || fileSize < sizeof(header) + SECTION_COUNT * sizeof(Section))
+    return fail("bad section table");
+
+  const std::size_t n = header.count, ns = header.strings;
+  const Section* sections = reinterpret_cast<const Section*>(data + sizeof(header));
+  const std::size_t dataStart = sizeof(header) + SECTION_COUNT * sizeof(Section);
+  for (std::size_t i = 0; i < SECTION_COUNT; ++i) {
+    const Section& s = sections[i];
+    if (s.kind != i + 1 || s.offset % ALIGN != 0 || s.offset < dataStart
+        || s.offset > fileSize || s.size > fileSize - s.offset)
+      return fail("bad section " + std::to_string(i + 1));
+  }
+  const auto expect = [&](SectionKind kind, std::size_t size) {
+    return sections[kind - 1].size == size;
+  };
+  const auto at = [&](SectionKind kind) {
+    return data + sections[kind - 1].offset;
+  };
+  for (int k = LON; k <= ICAO; ++k) {
+    if (!expect(SectionKind(k), 4*n))
+      return fail("bad column size");
+  }
+  if (!expect(STRING_OFFSETS, 4*(ns + 1)) || !expect(UNIT_VECTORS, 24*n)
+      || !expect(SYNOP_ORDER, 4*n) || !expect(DBKEY_ORDER, 4*n) || !expect(NAME_ORDER, 4*n)
+      || sections[ICAO_ORDER - 1].size % 4 != 0 || sections[ICAO_ORDER - 1].size > 4*n
+      || !expect(CELL_IDS, 8*n) || !expect(CELL_ORDER, 4*n))
+    return fail("bad index size");
+
+  mCount = n;
+  mStrings = ns;
+  mIcaoCount = sections[ICAO_ORDER - 1].size / 4;
+  mLon = reinterpret_cast<const int32_t*>(at(LON));
+  mLat = reinterpret_cast<const int32_t*>(at(LAT));
+  mSynop = reinterpret_cast<const int32_t*>(at(SYNOP));
+  mDbKey = reinterpret_cast<const int32_t*>(at(DBKEY));
+  mHeight = reinterpret_cast<const int32_t*>(at(HEIGHT));
+  mPriority = reinterpret_cast<const int32_t*>(at(PRIORITY));
+  mName = reinterpret_cast<const uint32_t*>(at(NAME));
+  mGroup = reinterpret_cast<const uint32_t*>(at(GROUP));
+  mIcao = reinterpret_cast<const uint32_t*>(at(ICAO));
+  mStringOffsets = reinterpret_cast<const uint32_t*>(at(STRING_OFFSETS));
+  mChars = at(STRING_CHARS);
+  mUnitVectors = reinterpret_cast<const double*>(at(UNIT_VECTORS));
+  mSynopOrder = reinterpret_cast<const uint32_t*>(at(SYNOP_ORDER));
+  mDbKeyOrder = reinterpret_cast<const uint32_t*>(at(DBKEY_ORDER));
+  mNameOrder = reinterpret_cast<const uint32_t*>(at(NAME_ORDER));
+  mIcaoOrder = reinterpret_cast<const uint32_t*>(at(ICAO_ORDER));
+  mCellIds = reinterpret_cast<const uint64_t*>(at(CELL_IDS));
+  mCellOrder = reinterpret_cast<const uint32_t*>(at(CELL_ORDER));
+
+  // strings
+  if (mStringOffsets[0] != 0 || !expect(STRING_CHARS, mStringOffsets[ns]))
+    return fail("bad string table");
+  for (std::size_t i = 0; i < ns; ++i) {
+    if (mStringOffsets[i] > mStringOffsets[i+1])
+      return fail("bad string table");
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    if (mName[i] >= ns || mGroup[i] >= ns || mIcao[i] >= ns)
+      return fail("bad string id");
+  }
+
+  // id indices
+  const auto bySynop = [this](uint32_t a, uint32_t b) { return compareInts(mSynop[a], mSynop[b]); };
+  const auto byDbKey = [this](uint32_t a, uint32_t b) { return compareInts(mDbKey[a], mDbKey[b]); };
+  const auto byName = [this](uint32_t a, uint32_t b) { return str(mName[a]).compare(str(mName[b])); };
+  const auto byIcao = [this](uint32_t a, uint32_t b) { return str(mIcao[a]).compare(str(mIcao[b])); };
+  if (!isSortedBy(mSynopOrder, n, n, bySynop) || !isSortedBy(mDbKeyOrder, n, n, byDbKey)
+      || !isSortedBy(mNameOrder, n, n, byName) || !isSortedBy(mIcaoOrder, mIcaoCount, n, byIcao))
+    return fail("bad id index");
+  std::size_t icaos = 0;
+  for (std::size_t i = 0; i < n; ++i)
+    icaos += !str(mIcao[i]).empty();
+  for (std::size_t k = 0; k < mIcaoCount; ++k) {
+    if (str(mIcao[mIcaoOrder[k]]).empty())
+      return fail("bad id index");
+  }
+  if (icaos != mIcaoCount)
+    return fail("bad id index");
+
+  // spatial index
+  for (std::size_t k = 0; k < n; ++k) {
+    const uint32_t row = mCellOrder[k];
+    if (row >= n || mCellIds[k] != miCellId::fromCoordinates(coordinates(row)).id())
+      return fail("bad spatial index");
+    if (k > 0 && (mCellIds[k-1] > mCellIds[k] || (mCellIds[k-1] == mCellIds[k] && mCellOrder[k-1] >= row)))
+      return fail("bad spatial index");
+  }
+  return true;
+}
+
+miCoordinates miStationCatalog::coordinates(std::size_t row) const
+{
+  return miPositionTable::fromCmin(mLon[row], mLat[row]);
+}
+
+miPosition miStationCatalog::position(std::size_t row) const
+{
+  miPosition p(coordinates(row), synop(row), dbKey(row), name(row),
+      height(row), priority(row), group(row));
+  p.setIcao(icao(row));
+  return p;
+}
+
+miStationCatalog::Rows miStationCatalog::rowsWithInt(const uint32_t* order, std::size_t count,
+    const int32_t* column, int key) const
+{
+  if (key == 0)
+    return Rows(order, order); // no synop or dbKey, as in miStationRegistry
+  const uint32_t* end = order + count;
+  const uint32_t* lo = std::lower_bound(order, end, key,
+      [column](uint32_t row, int k) { return column[row] < k; });
+  const uint32_t* hi = std::upper_bound(lo, end, key,
+      [column](int k, uint32_t row) { return k < column[row]; });
+  return Rows(lo, hi);
+}
+
+miStationCatalog::Rows miStationCatalog::rowsWithString(const uint32_t* order, std::size_t count,
+    const uint32_t* column, std::string_view key) const
+{
+  const uint32_t* end = order + count;
+  const uint32_t* lo = std::lower_bound(order, end, key,
+      [this, column](uint32_t row, std::string_view k) { return str(column[row]) < k; });
+  const uint32_t* hi = std::upper_bound(lo, end, key,
+      [this, column](std::string_view k, uint32_t row) { return k < str(column[row]); });
+  return Rows(lo, hi);
+}
+
+miStationCatalog::Rows miStationCatalog::rowsWithSynop(int synop) const
+{
+  return rowsWithInt(mSynopOrder, mCount, mSynop, synop);
+}
+
+miStationCatalog::Rows miStationCatalog::rowsWithDbKey(int dbKey) const
+{
+  return rowsWithInt(mDbKeyOrder, mCount, mDbKey, dbKey);
+}
+
+miStationCatalog::Rows miStationCatalog::rowsWithName(std::string_view name) const
+{
+  return rowsWithString(mNameOrder, mCount, mName, name);
+}
+
+miStationCatalog::Rows miStationCatalog::rowsWithIcao(std::string_view icao) const
+{
+  if (icao.empty())
+    return Rows(mIcaoOrder, mIcaoOrder);
+  return rowsWithString(mIcaoOrder, mIcaoCount, mIcao, icao);
+}
+
+void miStationCatalog::within(const miCoordinates& c, double radius, std::vector<std::size_t>& indices) const
+{
+  indices.clear();
+  if (radius < 0 || mCount == 0)
+    return;
+  const double chord2 = chord2ForDistance(radius);
+  double xyz[3];
+  PreparedLonLat(c.lonLat()).unitVector(xyz);
+  const auto check = [&](uint32_t row) {
+    const double* p = mUnitVectors + 3*row;
+    const double dx = p[0] - xyz[0], dy = p[1] - xyz[1], dz = p[2] - xyz[2];
+    if (dx*dx + dy*dy + dz*dz <= chord2)
+      indices.push_back(row);
+  };
+
+  // lon/lat rectangle around the circle, split at the date line
+  const double angle = radius / EARTH_RADIUS_M * (180 / M_PI) * (1 + 1e-9) + 1e-9;
+  const double lat = c.dLat(), lon = c.dLon();
+  const double latMin = std::max(-90.0, lat - angle), latMax = std::min(90.0, lat + angle);
+  double dlon = 180;
+  if (latMin > -90 && latMax < 90 && angle < 90) {
+    const double s = std::sin(angle * M_PI / 180) / std::cos(lat * M_PI / 180);
+    if (s < 1)
+      dlon = std::asin(s) * (180 / M_PI) * (1 + 1e-9) + 1e-9;
+  }
+  if (dlon >= 180) {
+    for (std::size_t row = 0; row < mCount; ++row)
+      check(uint32_t(row));
+    return;
+  }
+
+  std::vector<miCellId> cells, more;
+  const int MAX_LEVEL = 16;
+  const std::size_t MAX_CELLS = 32;
+  miCellId::cover(std::max(-180.0, lon - dlon), latMin, std::min(180.0, lon + dlon), latMax,
+      MAX_LEVEL, MAX_CELLS, cells);
+  if (lon - dlon < -180)
+    miCellId::cover(lon - dlon + 360, latMin, 180, latMax, MAX_LEVEL, MAX_CELLS, more);
+  else if (lon + dlon > 180)
+    miCellId::cover(-180, latMin, lon + dlon - 360, latMax, MAX_LEVEL, MAX_CELLS, more);
+  cells.insert(cells.end(), more.begin(), more.end());
+
+  const uint64_t* end = mCellIds + mCount;
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    const uint64_t* lo = std::lower_bound(mCellIds, end, cells[i].rangeMin());
+    const uint64_t* hi = std::upper_bound(lo, end, cells[i].rangeMax());
+    for (const uint64_t* it = lo; it != hi; ++it)
+      check(mCellOrder[it - mCellIds]);
+  }
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
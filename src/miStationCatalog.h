@@ -0,0 +1,171 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miStationCatalog_h
+#define puDatatypes_miStationCatalog_h
+
+#include "miMappedFile.h"
+#include "miPositionTable.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*! Binary station catalog, memory-mapped and queried in place.
+ *
+ *  The file holds the columns of an miPositionTable, its string pool,
+ *  rows sorted by synop, dbKey, name and ICAO id, and rows sorted by
+ *  miCellId as spatial index. All references are offsets from the
+ *  start of the file, so nothing needs to be deserialized; open() only
+ *  validates the file, in time linear in its size.
+ *
+ *  The file uses the byte order of the machine that wrote it; open()
+ *  rejects files with another byte order or version.
+ */
+class miStationCatalog {
+public:
+  enum { VERSION = 1 };
+
+  //! returned for keys that are not found
+  static const std::size_t NONE = ~std::size_t(0);
+
+  //! rows with the same key, in ascending order
+  class Rows {
+  public:
+    Rows(const uint32_t* begin, const uint32_t* end)
+      : mBegin(begin), mEnd(end) { }
+    const uint32_t* begin() const { return mBegin; }
+    const uint32_t* end() const { return mEnd; }
+    std::size_t size() const { return mEnd - mBegin; }
+    bool empty() const { return mBegin == mEnd; }
+  private:
+    const uint32_t* mBegin;
+    const uint32_t* mEnd;
+  };
+
+  miStationCatalog();
+
+  /*! write 'table' as catalog; returns false and sets 'error' on failure
+   *
+   *  The catalog is written to a temporary file, with permissions from
+   *  the umask, and renamed to 'filename'. Readers see either the old or
+   *  the new catalog. If only the final sync of the directory fails,
+   *  write returns false although 'filename' already is the new catalog;
+   *  the rename may then be lost after a crash.
+   */
+  static bool write(const std::string& filename, const miPositionTable& table, std::string* error = 0);
+
+  //! map and validate 'filename'; returns false if the file is not a valid catalog, see error()
+  bool open(const std::string& filename);
+  void close();
+
+  bool isOpen() const
+    { return mFile.isOpen(); }
+
+  //! reason for the last failure of open()
+  const std::string& error() const
+    { return mError; }
+
+  std::size_t size() const
+    { return mCount; }
+
+  miCoordinates coordinates(std::size_t row) const;
+  int synop(std::size_t row) const    { return mSynop[row]; }
+  int dbKey(std::size_t row) const    { return mDbKey[row]; }
+  int height(std::size_t row) const   { return mHeight[row]; }
+  int priority(std::size_t row) const { return mPriority[row]; }
+  std::string_view name(std::size_t row) const  { return str(mName[row]); }
+  std::string_view group(std::size_t row) const { return str(mGroup[row]); }
+  std::string_view icao(std::size_t row) const  { return str(mIcao[row]); }
+
+  //! a copy as miPosition
+  miPosition position(std::size_t row) const;
+
+  //! rows with 'synop' or 'dbKey'; 0 means none and is not indexed
+  Rows rowsWithSynop(int synop) const;
+  Rows rowsWithDbKey(int dbKey) const;
+  Rows rowsWithName(std::string_view name) const;
+  //! rows with ICAO id 'icao'; empty ICAO ids are not indexed
+  Rows rowsWithIcao(std::string_view icao) const;
+
+  //! first row with 'synop', or NONE
+  std::size_t findSynop(int synop) const
+    { return first(rowsWithSynop(synop)); }
+  std::size_t findDbKey(int dbKey) const
+    { return first(rowsWithDbKey(dbKey)); }
+  std::size_t findName(std::string_view name) const
+    { return first(rowsWithName(name)); }
+  std::size_t findIcao(std::string_view icao) const
+    { return first(rowsWithIcao(icao)); }
+
+  //! all rows within 'radius' m from 'c', sorted by row
+  void within(const miCoordinates& c, double radius, std::vector<std::size_t>& indices) const;
+
+private:
+  static std::size_t first(const Rows& rows)
+    { return rows.empty() ? NONE : *rows.begin(); }
+
+  std::string_view str(uint32_t id) const
+    { return std::string_view(mChars + mStringOffsets[id], mStringOffsets[id+1] - mStringOffsets[id]); }
+
+  Rows rowsWithInt(const uint32_t* order, std::size_t count, const int32_t* column, int key) const;
+  Rows rowsWithString(const uint32_t* order, std::size_t count, const uint32_t* column,
+      std::string_view key) const;
+
+  bool validate();
+  bool fail(const std::string& error);
+
+private:
+  miMappedFile mFile;
+  std::string mError;
+
+  std::size_t mCount;
+  std::size_t mStrings;
+  std::size_t mIcaoCount;
+  const int32_t* mLon;
+  const int32_t* mLat;
+  const int32_t* mSynop;
+  const int32_t* mDbKey;
+  const int32_t* mHeight;
+  const int32_t* mPriority;
+  const uint32_t* mName;
+  const uint32_t* mGroup;
+  const uint32_t* mIcao;
+  const uint32_t* mStringOffsets;
+  const char* mChars;
+  const double* mUnitVectors;
+  const uint32_t* mSynopOrder;
+  const uint32_t* mDbKeyOrder;
+  const uint32_t* mNameOrder;
+  const uint32_t* mIcaoOrder;
+  const uint64_t* mCellIds;
+  const uint32_t* mCellOrder;
+};
+
+#endif // puDatatypes_miStationCatalog_h
@@ -0,0 +1,149 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miStationRegistry.h"
+
+#include <utility>
+
+const std::size_t miStationRegistry::NONE;
+const miStationRegistry::row_t miStationRegistry::NO_ROW;
+
+namespace {
+
+// fibonacci hashing; 'shift' selects the top bits
+inline std::size_t slotOf(int key, int shift)
+{
+  return std::size_t((uint32_t(key) * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+} // namespace
+
+/* ====== IntIndex ====== */
+
+void miStationRegistry::IntIndex::build(const int* keys, std::size_t count)
+{
+  // at least twice as many slots as keys
+  int bits = 4;
+  while ((std::size_t(1) << bits) < 2*count)
+    bits += 1;
+  mShift = 64 - bits;
+  const Slot empty = { 0, NO_ROW };
+  mSlots.assign(std::size_t(1) << bits, empty);
+  mNext.assign(count, NO_ROW);
+
+  // insert backwards so that each chain is in ascending row order
+  const std::size_t mask = mSlots.size() - 1;
+  for (std::size_t row = count; row-- > 0; ) {
+    if (keys[row] == 0)
+      continue; // no synop or dbKey
+    std::size_t s = slotOf(keys[row], mShift);
+    while (mSlots[s].row != NO_ROW && mSlots[s].key != keys[row])
+      s = (s + 1) & mask;
+    mNext[row] = mSlots[s].row;
+    mSlots[s].key = keys[row];
+    mSlots[s].row = row_t(row);
+  }
+}
+
+std::size_t miStationRegistry::IntIndex::find(int key) const
+{
+  if (mSlots.empty())
+    return NONE;
+  const std::size_t mask = mSlots.size() - 1;
+  for (std::size_t s = slotOf(key, mShift); mSlots[s].row != NO_ROW; s = (s + 1) & mask) {
+    if (mSlots[s].key == key)
+      return mSlots[s].row;
+  }
+  return NONE;
+}
+
+/* ====== StringIndex ====== */
+
+void miStationRegistry::StringIndex::build(const miStringPool::id_t* ids, std::size_t count,
+    std::size_t nids, miStringPool::id_t skip)
+{
+  mFirst.assign(nids, NO_ROW);
+  mNext.assign(count, NO_ROW);
+  for (std::size_t row = count; row-- > 0; ) {
+    const miStringPool::id_t id = ids[row];
+    if (id == skip)
+      continue;
+    mNext[row] = mFirst[id];
+    mFirst[id] = row_t(row);
+  }
+}
+
+/* ====== miStationRegistry ====== */
+
+miStationRegistry::miStationRegistry(const std::vector<miPosition>& positions)
+  : mTable(positions)
+{
+  buildIndices();
+}
+
+miStationRegistry::miStationRegistry(miPositionTable table)
+  : mTable(std::move(table))
+{
+  buildIndices();
+}
+
+void miStationRegistry::buildIndices()
+{
+  const std::size_t n = mTable.size();
+  const std::size_t nids = mTable.strings().size();
+  const miStringPool::id_t empty = mTable.strings().find("");
+  mSynop.build(mTable.synops(), n);
+  mDbKey.build(mTable.dbKeys(), n);
+  mIcao.build(mTable.icaoIds(), n, nids, empty);
+  mName.build(mTable.nameIds(), n, nids, empty);
+}
+
+std::size_t miStationRegistry::findIcao(std::string_view icao) const
+{
+  return mIcao.find(mTable.strings().find(icao));
+}
+
+std::size_t miStationRegistry::findName(std::string_view name) const
+{
+  return mName.find(mTable.strings().find(name));
+}
+
+std::size_t miStationRegistry::next(Index index, std::size_t row) const
+{
+  switch (index) {
+  case SYNOP:
+    return mSynop.next(row);
+  case DBKEY:
+    return mDbKey.next(row);
+  case ICAO:
+    return mIcao.next(row);
+  case NAME:
+    return mName.next(row);
+  }
+  return NONE;
+}
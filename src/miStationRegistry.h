@@ -0,0 +1,129 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miStationRegistry_h
+#define puDatatypes_miStationRegistry_h
+
+#include "miPositionTable.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/*! Station table with hash indices on synop, dbKey, ICAO id and name.
+ *
+ *  The indices are built once, when the registry is constructed. The
+ *  string indices map the ids of the table's string pool to rows, so
+ *  no string is stored twice. Synops and dbKeys that are 0 (the
+ *  miPosition default) and empty ICAO ids and names are not indexed.
+ *
+ *  When several rows have the same key, find* returns the lowest row
+ *  and next() walks through the others in ascending order.
+ */
+class miStationRegistry {
+public:
+  enum Index { SYNOP, DBKEY, ICAO, NAME };
+
+  //! returned for keys that are not found
+  static const std::size_t NONE = ~std::size_t(0);
+
+  miStationRegistry() { }
+  explicit miStationRegistry(const std::vector<miPosition>& positions);
+  explicit miStationRegistry(miPositionTable table);
+
+  const miPositionTable& table() const
+    { return mTable; }
+
+  std::size_t size() const
+    { return mTable.size(); }
+
+  miPositionTable::Row operator[](std::size_t row) const
+    { return mTable[row]; }
+
+  std::size_t findSynop(int synop) const
+    { return mSynop.find(synop); }
+  std::size_t findDbKey(int dbKey) const
+    { return mDbKey.find(dbKey); }
+  std::size_t findIcao(std::string_view icao) const;
+  std::size_t findName(std::string_view name) const;
+
+  //! the next row after 'row' with the same key in 'index', or NONE
+  std::size_t next(Index index, std::size_t row) const;
+
+private:
+  typedef uint32_t row_t;
+  static const row_t NO_ROW = ~row_t(0);
+
+  static std::size_t toSize(row_t row)
+    { return row == NO_ROW ? NONE : row; }
+
+  //! open-addressing hash from int key to the first of a chain of rows
+  class IntIndex {
+  public:
+    IntIndex() : mShift(64) { }
+    void build(const int* keys, std::size_t count);
+    std::size_t find(int key) const;
+    std::size_t next(std::size_t row) const
+      { return toSize(mNext[row]); }
+
+  private:
+    struct Slot {
+      int key;
+      row_t row;
+    };
+    std::vector<Slot> mSlots;   //!< row is NO_ROW for empty slots
+    std::vector<row_t> mNext;
+    int mShift;
+  };
+
+  //! string pool id to the first of a chain of rows
+  class StringIndex {
+  public:
+    void build(const miStringPool::id_t* ids, std::size_t count, std::size_t nids,
+        miStringPool::id_t skip);
+    std::size_t find(miStringPool::id_t id) const
+      { return (id < mFirst.size()) ? toSize(mFirst[id]) : NONE; }
+    std::size_t next(std::size_t row) const
+      { return toSize(mNext[row]); }
+
+  private:
+    std::vector<row_t> mFirst;
+    std::vector<row_t> mNext;
+  };
+
+  void buildIndices();
+
+private:
+  miPositionTable mTable;
+  IntIndex mSynop;
+  IntIndex mDbKey;
+  StringIndex mIcao;
+  StringIndex mName;
+};
+
+#endif // puDatatypes_miStationRegistry_h
@@ -0,0 +1,119 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miStringPool.h"
+
+#include <functional>
+
+const miStringPool::id_t miStringPool::NONE;
+
+namespace {
+
+const std::size_t MIN_SLOTS = 16;
+
+inline uint32_t hashOf(std::string_view s)
+{
+  return uint32_t(std::hash<std::string_view>()(s));
+}
+
+} // namespace
+
+miStringPool::miStringPool()
+{
+  clear();
+}
+
+void miStringPool::clear()
+{
+  mChars.clear();
+  mOffsets.assign(1, 0);
+  mHashes.clear();
+  mSlots.assign(MIN_SLOTS, 0);
+}
+
+void miStringPool::reserve(std::size_t count, std::size_t chars)
+{
+  mChars.reserve(chars);
+  mOffsets.reserve(count + 1);
+  mHashes.reserve(count);
+  std::size_t slots = mSlots.size();
+  while (slots < 2*count)
+    slots *= 2;
+  if (slots != mSlots.size())
+    rehash(slots);
+}
+
+// the slot holding 's', or the empty slot where it would go
+std::size_t miStringPool::slotFor(std::string_view s, std::size_t hash) const
+{
+  const std::size_t mask = mSlots.size() - 1;
+  for (std::size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+    const id_t id = mSlots[slot];
+    if (id == 0 || (mHashes[id-1] == hash && str(id-1) == s))
+      return slot;
+  }
+}
+
+void miStringPool::rehash(std::size_t slots)
+{
+  mSlots.assign(slots, 0);
+  const std::size_t mask = slots - 1;
+  for (std::size_t id = 0; id < mHashes.size(); ++id) {
+    std::size_t slot = mHashes[id] & mask;
+    while (mSlots[slot] != 0)
+      slot = (slot + 1) & mask;
+    mSlots[slot] = id_t(id + 1);
+  }
+}
+
+miStringPool::id_t miStringPool::find(std::string_view s) const
+{
+  const id_t id = mSlots[slotFor(s, hashOf(s))];
+  return id == 0 ? NONE : id - 1;
+}
+
+miStringPool::id_t miStringPool::intern(std::string_view s)
+{
+  const uint32_t hash = hashOf(s);
+  std::size_t slot = slotFor(s, hash);
+  if (mSlots[slot] != 0)
+    return mSlots[slot] - 1;
+
+  const id_t id = id_t(size());
+  mChars.append(s.data(), s.size());
+  mOffsets.push_back(uint32_t(mChars.size()));
+  mHashes.push_back(hash);
+
+  // keep the load factor at or below 1/2
+  if (2*mHashes.size() > mSlots.size()) {
+    rehash(2*mSlots.size());
+    slot = slotFor(s, hash);
+  }
+  mSlots[slot] = id + 1;
+  return id;
+}
@@ -0,0 +1,88 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miStringPool_h
+#define puDatatypes_miStringPool_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*! Interned strings, identified by small consecutive ids.
+ *
+ *  All characters are kept in one buffer; each distinct string is stored
+ *  once. Lookup uses an open-addressing hash table over the ids.
+ *
+ *  The string_views returned by str() are invalidated by intern().
+ */
+class miStringPool {
+public:
+  typedef uint32_t id_t;
+
+  //! returned by find() for strings not in the pool
+  static const id_t NONE = ~id_t(0);
+
+  miStringPool();
+
+  //! the id of 's', adding it if it is not in the pool yet
+  id_t intern(std::string_view s);
+
+  //! the id of 's', or NONE
+  id_t find(std::string_view s) const;
+
+  //! the string with id 'id'
+  std::string_view str(id_t id) const
+    { return std::string_view(mChars.data() + mOffsets[id], mOffsets[id+1] - mOffsets[id]); }
+
+  //! number of distinct strings
+  std::size_t size() const
+    { return mOffsets.size() - 1; }
+
+  //! total length of all distinct strings
+  std::size_t chars() const
+    { return mChars.size(); }
+
+  //! prepare for 'count' strings with 'chars' characters in total
+  void reserve(std::size_t count, std::size_t chars);
+
+  void clear();
+
+private:
+  std::size_t slotFor(std::string_view s, std::size_t hash) const;
+  void rehash(std::size_t slots);
+
+private:
+  std::string mChars;
+  std::vector<uint32_t> mOffsets; //!< size()+1 offsets into mChars
+  std::vector<uint32_t> mHashes;  //!< hash of each string, for rehash and quick mismatch
+  std::vector<id_t> mSlots;       //!< id+1 or 0 for empty, size is a power of 2
+};
+
+#endif // puDatatypes_miStringPool_h
@@ -0,0 +1,201 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miSymbol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+struct Entry {
+  const char* data;
+  uint32_t size;
+};
+
+// two-level id table; blocks are allocated once and never moved, so
+// readers need no lock
+const std::size_t BLOCK_BITS = 14, BLOCK_SIZE = std::size_t(1) << BLOCK_BITS;
+const std::size_t MAX_BLOCKS = std::size_t(1) << 14;
+
+// chars are allocated from chunks that are never moved or freed
+const std::size_t CHUNK_SIZE = 64*1024;
+
+const std::size_t SHARDS = 16;
+
+// spreads a std::hash value, which may have only 32 bits, over 64 bits
+// (splitmix64 finalizer)
+uint64_t mix(uint64_t k)
+{
+  k = (k ^ (k >> 30)) * 0xbf58476d1ce4e5b9ull;
+  k = (k ^ (k >> 27)) * 0x94d049bb133111ebull;
+  return k ^ (k >> 31);
+}
+
+// open-addressing hash table from string to id, plus char storage
+struct Shard {
+  std::mutex mutex;
+  std::vector<uint32_t> slots;  // id, or 0 for empty; size is a power of 2
+  std::vector<uint32_t> hashes; // hash of the string in each slot
+  std::size_t used = 0;
+  char* chunk = 0;
+  std::size_t chunkLeft = 0;
+
+  const char* store(std::string_view s);
+};
+
+struct Table {
+  Shard shards[SHARDS];
+  std::atomic<Entry*> blocks[MAX_BLOCKS];
+  std::mutex blocksMutex;
+  std::atomic<uint32_t> next;
+
+  Table();
+  Entry& entry(uint32_t id);
+};
+
+const char* Shard::store(std::string_view s)
+{
+  if (s.size() > CHUNK_SIZE / 4) {
+    char* p = new char[s.size()];
+    std::memcpy(p, s.data(), s.size());
+    return p;
+  }
+  if (s.size() > chunkLeft) {
+    chunk = new char[CHUNK_SIZE];
+    chunkLeft = CHUNK_SIZE;
+  }
+  char* p = chunk;
+  std::memcpy(p, s.data(), s.size());
+  chunk += s.size();
+  chunkLeft -= s.size();
+  return p;
+}
+
+Table::Table()
+  : next(1)
+{
+  for (std::size_t b = 0; b < MAX_BLOCKS; ++b)
+    blocks[b].store(0, std::memory_order_relaxed);
+  Entry& empty = entry(0);
+  empty.data = "";
+  empty.size = 0;
+}
+
+Entry& Table::entry(uint32_t id)
+{
+  std::atomic<Entry*>& block = blocks[id >> BLOCK_BITS];
+  Entry* b = block.load(std::memory_order_acquire);
+  if (!b) {
+    std::lock_guard<std::mutex> lock(blocksMutex);
+    b = block.load(std::memory_order_relaxed);
+    if (!b) {
+      b = new Entry[BLOCK_SIZE];
+      block.store(b, std::memory_order_release);
+    }
+  }
+  return b[id & (BLOCK_SIZE - 1)];
+}
+
+Table& table()
+{
+  // never destroyed, so that symbols stay valid during static destruction
+  static Table* t = new Table;
+  return *t;
+}
+
+} // namespace
+
+uint32_t miSymbol::intern(std::string_view s)
+{
+  if (s.empty())
+    return 0;
+
+  Table& t = table();
+  // shard from the low bits, probe hash from the high bits
+  const uint64_t hash = mix(std::hash<std::string_view>()(s));
+  Shard& shard = t.shards[hash % SHARDS];
+  const uint32_t h = uint32_t(hash >> 32);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  // keep the load factor at or below 1/2
+  if (2*(shard.used + 1) > shard.slots.size()) {
+    const std::size_t size = std::max<std::size_t>(64, 2*shard.slots.size());
+    std::vector<uint32_t> slots(size, 0), hashes(size, 0);
+    for (std::size_t i = 0; i < shard.slots.size(); ++i) {
+      if (shard.slots[i] == 0)
+        continue;
+      std::size_t k = shard.hashes[i] & (size - 1);
+      while (slots[k] != 0)
+        k = (k + 1) & (size - 1);
+      slots[k] = shard.slots[i];
+      hashes[k] = shard.hashes[i];
+    }
+    shard.slots.swap(slots);
+    shard.hashes.swap(hashes);
+  }
+
+  const std::size_t mask = shard.slots.size() - 1;
+  std::size_t k = h & mask;
+  for (; shard.slots[k] != 0; k = (k + 1) & mask) {
+    if (shard.hashes[k] == h) {
+      const Entry& e = t.entry(shard.slots[k]);
+      if (std::string_view(e.data, e.size) == s)
+        return shard.slots[k];
+    }
+  }
+
+  const uint32_t id = t.next.fetch_add(1);
+  if (id >= MAX_BLOCKS * BLOCK_SIZE)
+    throw std::length_error("too many miSymbol strings");
+  Entry& e = t.entry(id);
+  e.data = shard.store(s);
+  e.size = uint32_t(s.size());
+  shard.slots[k] = id;
+  shard.hashes[k] = h;
+  shard.used += 1;
+  return id;
+}
+
+std::string_view miSymbol::str() const
+{
+  // the entry was written before this symbol could be created
+  const Entry& e = table().entry(mId);
+  return std::string_view(e.data, e.size);
+}
+
+std::size_t miSymbol::count()
+{
+  return table().next.load();
+}
@@ -0,0 +1,79 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef puDatatypes_miSymbol_h
+#define puDatatypes_miSymbol_h
+
+#include <cstdint>
+#include <string_view>
+
+/*! Handle to a string in a process-wide table of interned strings.
+ *
+ *  Each distinct string is stored once, in an arena that is never moved
+ *  or freed, so a miSymbol is 4 bytes and str() stays valid for the
+ *  lifetime of the process. Interning takes a lock on one of several
+ *  shards; str() takes no lock. Symbols compare equal exactly when their
+ *  strings are equal. The default symbol is the empty string.
+ *
+ *  Meant for names, groups and ids from a bounded vocabulary, such as
+ *  station metadata. The table only grows: there is no way to release a
+ *  string, so reloading stations (miConcurrentRegistry::publish) keeps
+ *  every name ever loaded, at a cost of its length plus a few tens
+ *  of bytes each. Strings that keep changing, such as timestamps,
+ *  must not be interned.
+ */
+class miSymbol {
+public:
+  miSymbol()
+    : mId(0) { }
+  explicit miSymbol(std::string_view s)
+    : mId(intern(s)) { }
+
+  std::string_view str() const;
+
+  uint32_t id() const
+    { return mId; }
+
+  bool empty() const
+    { return mId == 0; }
+
+  friend bool operator==(const miSymbol& a, const miSymbol& b)
+    { return a.mId == b.mId; }
+  friend bool operator!=(const miSymbol& a, const miSymbol& b)
+    { return a.mId != b.mId; }
+
+  //! number of distinct strings interned so far, including the empty string
+  static std::size_t count();
+
+private:
+  static uint32_t intern(std::string_view s);
+
+  uint32_t mId;
+};
+
+#endif // puDatatypes_miSymbol_h
@@ -1,9 +1,9 @@
 #ifndef METLIBS_PUDATATYPES_VERSION_H
 #define METLIBS_PUDATATYPES_VERSION_H
 
-#define METLIBS_PUDATATYPES_VERSION_MAJOR 6
+#define METLIBS_PUDATATYPES_VERSION_MAJOR 7
 #define METLIBS_PUDATATYPES_VERSION_MINOR 0
-#define METLIBS_PUDATATYPES_VERSION_PATCH 4
+#define METLIBS_PUDATATYPES_VERSION_PATCH 0
 
 #define METLIBS_PUDATATYPES_VERSION_INT(major,minor,patch) \
     (1000000*major + 1000*minor + patch)
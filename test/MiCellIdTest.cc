@@ -0,0 +1,119 @@
+#include "miCellId.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+TEST(MiCellIdTest, Levels)
+{
+  const miCellId c = miCellId::fromDegrees(10.72, 59.94);
+  EXPECT_TRUE(c.isValid());
+  EXPECT_EQ(miCellId::MAX_LEVEL, c.level());
+  EXPECT_FALSE(miCellId().isValid());
+
+  miCellId p = c;
+  for (int level = miCellId::MAX_LEVEL - 1; level >= 0; --level) {
+    p = p.parent();
+    EXPECT_TRUE(p.isValid());
+    EXPECT_EQ(level, p.level());
+    EXPECT_EQ(p, c.parent(level));
+    EXPECT_TRUE(p.contains(c));
+    EXPECT_EQ(p, miCellId::fromDegrees(10.72, 59.94, level));
+  }
+
+  const miCellId c10 = c.parent(10);
+  for (int k = 0; k < 4; ++k) {
+    const miCellId ch = c10.child(k);
+    EXPECT_EQ(11, ch.level());
+    EXPECT_EQ(c10, ch.parent());
+    EXPECT_TRUE(c10.contains(ch));
+    if (k > 0) {
+      EXPECT_LT(c10.child(k-1), ch);
+    }
+  }
+  EXPECT_EQ(c10.rangeMin(), c10.child(0).rangeMin());
+  EXPECT_EQ(c10.rangeMax(), c10.child(3).rangeMax());
+  EXPECT_TRUE(c10.contains(c10.child(2).child(1)));
+  EXPECT_FALSE(c10.child(2).contains(c10.child(1)));
+}
+
+TEST(MiCellIdTest, Coordinates)
+{
+  double lonMin, latMin, lonMax, latMax;
+  const miCellId c = miCellId::fromCoordinates(miCoordinates(10.72f, 59.94f), 16);
+  c.bounds(lonMin, latMin, lonMax, latMax);
+  EXPECT_LE(lonMin, 10.72);
+  EXPECT_GE(lonMax, 10.72);
+  EXPECT_LE(latMin, 59.94);
+  EXPECT_GE(latMax, 59.94);
+
+  // centiminute coordinates agree with floating point degrees
+  for (int lon = -1800000; lon < 1800000; lon += 123457) {
+    for (int lat = -900000; lat <= 900000; lat += 54321) {
+      const miCoordinates mc(lon, lat);
+      const double dlon = mc.Lon().deg + mc.Lon().cmin / 6000.0;
+      const double dlat = mc.Lat().deg + mc.Lat().cmin / 6000.0;
+      EXPECT_EQ(miCellId::fromDegrees(dlon, dlat, 20), miCellId::fromCoordinates(mc, 20));
+    }
+  }
+
+  uint32_t i, j;
+  miCellId::fromIJ(12345, 678, 16).getIJ(i, j);
+  EXPECT_EQ(12345u, i);
+  EXPECT_EQ(678u, j);
+}
+
+TEST(MiCellIdTest, Neighbours)
+{
+  const miCellId c = miCellId::fromIJ(0, 5, 4);
+  uint32_t i, j;
+  c.neighbour(-1, 1).getIJ(i, j);
+  EXPECT_EQ(15u, i);
+  EXPECT_EQ(6u, j);
+  EXPECT_FALSE(miCellId::fromIJ(3, 15, 4).neighbour(0, 1).isValid());
+
+  std::vector<miCellId> n;
+  c.neighbours(n);
+  EXPECT_EQ(8u, n.size());
+  miCellId::fromIJ(3, 0, 4).neighbours(n);
+  EXPECT_EQ(5u, n.size());
+}
+
+TEST(MiCellIdTest, Cover)
+{
+  std::vector<miCellId> cells;
+  miCellId::cover(4, 57, 12, 64, 12, 0, cells);
+  ASSERT_FALSE(cells.empty());
+  EXPECT_TRUE(std::is_sorted(cells.begin(), cells.end()));
+
+  const double inside[][2] = { { 10.72, 59.94 }, { 5.33, 60.38 }, { 4.01, 57.02 }, { 11.99, 63.99 } };
+  for (const auto& p : inside)
+    EXPECT_TRUE(miCellId::covers(cells, miCellId::fromDegrees(p[0], p[1])));
+  const double outside[][2] = { { -10.72, 59.94 }, { 5.33, 70.38 }, { 3.9, 57.02 } };
+  for (const auto& p : outside)
+    EXPECT_FALSE(miCellId::covers(cells, miCellId::fromDegrees(p[0], p[1])));
+  for (size_t k = 0; k < cells.size(); ++k) {
+    double lonMin, latMin, lonMax, latMax;
+    cells[k].bounds(lonMin, latMin, lonMax, latMax);
+    EXPECT_TRUE(lonMax >= 4 && lonMin <= 12 && latMax >= 57 && latMin <= 64);
+  }
+
+  miCellId::cover(4, 57, 12, 64, 20, 40, cells);
+  EXPECT_GE(40u, cells.size());
+}
+
+TEST(MiCellIdTest, CoverDateline)
+{
+  std::vector<miCellId> cells;
+  miCellId::cover(170, -20, -170, -10, 12, 0, cells);
+  ASSERT_FALSE(cells.empty());
+  EXPECT_TRUE(std::is_sorted(cells.begin(), cells.end()));
+
+  const double inside[][2] = { { 178.44, -18.14 }, { -175.2, -15.0 }, { 170.01, -19.99 }, { -170.01, -10.01 } };
+  for (const auto& p : inside)
+    EXPECT_TRUE(miCellId::covers(cells, miCellId::fromDegrees(p[0], p[1])));
+  const double outside[][2] = { { 0, -15 }, { 169.9, -15 }, { -169.9, -15 }, { 178.44, -9.9 } };
+  for (const auto& p : outside)
+    EXPECT_FALSE(miCellId::covers(cells, miCellId::fromDegrees(p[0], p[1])));
+}
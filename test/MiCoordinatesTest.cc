@@ -4,6 +4,10 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
 static const float BLINDERN_LON = 10.72005f, BLINDERN_LAT = 59.9423f;
 static const float FANNARAK_LON =  7.9058f,  FANNARAK_LAT = 61.5158f;
 static const LonLat blindern = LonLat::fromDegrees(BLINDERN_LON, BLINDERN_LAT);
@@ -46,6 +50,27 @@ TEST(LonLatTest, DistanceTo)
       LonLat::fromDegrees(-175, -5).distanceTo(LonLat::fromDegrees(175, 5)));
 }
 
+TEST(LonLatTest, DistancesTo)
+{
+  std::vector<double> lons, lats;
+  for (int lat = -90; lat <= 90; lat += 15) {
+    for (int lon = -180; lon <= 180; lon += 20) {
+      lons.push_back(d2r(lon + 0.37));
+      lats.push_back(d2r(lat * 0.999));
+    }
+  }
+  lons.push_back(blindern.lon());
+  lats.push_back(blindern.lat());
+
+  std::vector<double> distances(lons.size());
+  const LonLat origins[] = { blindern, fannarak, LonLat::fromDegrees(-170, -89), LonLat::fromDegrees(0, 0) };
+  for (const LonLat& origin : origins) {
+    origin.distancesTo(&lons[0], &lats[0], lons.size(), &distances[0]);
+    for (size_t i = 0; i < lons.size(); ++i)
+      EXPECT_NEAR(origin.distanceTo(LonLat(lons[i], lats[i])), distances[i], 1e-3);
+  }
+}
+
 TEST(LonLatTest, BearingTo)
 {
   const float D = 0.1;
@@ -66,6 +91,39 @@ TEST(LonLatTest, BearingTo)
   EXPECT_NEAR(185, r2d(LonLat::fromDegrees(180, -89).bearingTo(LonLat::fromDegrees( 10, -89))), 0.25);
 }
 
+TEST(PreparedLonLatTest, Queries)
+{
+  const LonLat targets[] = { fannarak, blindern, LonLat::fromDegrees(BLINDERN_LON+0.001, BLINDERN_LAT),
+                             LonLat::fromDegrees(190, 89), LonLat::fromDegrees(-175, 5), LonLat::fromDegrees(10, -70) };
+  const LonLat origins[] = { blindern, LonLat::fromDegrees(10, 89), LonLat::fromDegrees(175, -5) };
+  for (const LonLat& o : origins) {
+    const PreparedLonLat po(o);
+    for (const LonLat& t : targets) {
+      const PreparedLonLat pt(t);
+      const double d = o.distanceTo(t), b = o.bearingTo(t);
+
+      EXPECT_NEAR(d, po.distanceTo(t), 1e-3);
+      EXPECT_NEAR(d, po.distanceTo(pt), 1e-3);
+
+      double pd, pb;
+      po.distanceAndBearingTo(t, pd, pb);
+      EXPECT_NEAR(d, pd, 1e-3);
+      if (d > 0) {
+        EXPECT_NEAR(b, po.bearingTo(t), 1e-9);
+        EXPECT_NEAR(b, po.bearingTo(pt), 1e-9);
+        EXPECT_NEAR(b, pb, 1e-9);
+        po.distanceAndBearingTo(pt, pd, pb);
+        EXPECT_NEAR(d, pd, 1e-3);
+        EXPECT_NEAR(b, pb, 1e-9);
+      }
+    }
+  }
+
+  const LonLat step100 = PreparedLonLat(blindern).stepDirection(100000, d2r(320));
+  EXPECT_NEAR(dms2r( 9,32,29), step100.lon(), 1e-4);
+  EXPECT_NEAR(dms2r(60,37,34), step100.lat(), 1e-4);
+}
+
 TEST(MiCoordinatesTest, Distance)
 {
   const miCoordinates bl(BLINDERN_LON, BLINDERN_LAT);
@@ -88,3 +146,248 @@ TEST(MiCoordinatesTest, StepTo)
   EXPECT_NEAR(dms2r(10, 8,13), step50.lon(), 1e-4);
   EXPECT_NEAR(dms2r(60,17, 8), step50.lat(), 1e-4);
 }
+
+TEST(GreatCircleTest, Interpolate)
+{
+  const GreatCircle gc(blindern, fannarak);
+  EXPECT_NEAR(blindern.distanceTo(fannarak), gc.length(), 1e-3);
+
+  const size_t N = 201;
+  std::vector<LonLat> points(N);
+  gc.interpolate(N, &points[0]);
+  EXPECT_EQ(blindern.lon(), points.front().lon());
+  EXPECT_EQ(blindern.lat(), points.front().lat());
+  EXPECT_NEAR(0, points.back().distanceTo(fannarak), 1e-3);
+  for (size_t i = 0; i < N; ++i) {
+    const LonLat expected = blindern.stepTo(i * gc.length() / (N-1), fannarak);
+    EXPECT_NEAR(expected.lon(), points[i].lon(), 1e-10);
+    EXPECT_NEAR(expected.lat(), points[i].lat(), 1e-10);
+  }
+
+  EXPECT_EQ(234u, gc.countForSpacing(1000));
+  EXPECT_GE(1000, gc.length() / (gc.countForSpacing(1000) - 1));
+}
+
+TEST(GreatCircleTest, StepEvery)
+{
+  const double bearing = d2r(320);
+  const GreatCircle gc = GreatCircle::fromBearing(blindern, bearing);
+  EXPECT_EQ(0, gc.length());
+
+  const size_t N = 500;
+  const double spacing = 25000;
+  std::vector<LonLat> points(N);
+  gc.stepEvery(spacing, N, &points[0]);
+  std::vector<double> distances(N);
+  for (size_t i = 0; i < N; ++i)
+    distances[i] = i * spacing;
+  std::vector<LonLat> stepped(N);
+  gc.stepDirections(&distances[0], N, &stepped[0]);
+
+  for (size_t i = 0; i < N; ++i) {
+    const LonLat expected = blindern.stepDirection(i * spacing, bearing);
+    EXPECT_NEAR(0, expected.distanceTo(points[i]), 1e-3);
+    EXPECT_NEAR(0, expected.distanceTo(stepped[i]), 1e-3);
+  }
+}
+
+TEST(LonLatTest, DistanceModes)
+{
+  // maximum relative errors as documented for DistanceMode
+  struct Band { double lat0, lat1, equirectangular; } bands[] = {
+    { 0, 30, 1e-5 }, { 30, 60, 5e-5 }, { 60, 80, 5e-4 }, { 80, 90, 0 }
+  };
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  for (const Band& b : bands) {
+    for (int i = 0; i < 20000; ++i) {
+      const double lat = (b.lat0 + (b.lat1 - b.lat0)*uniform(rng)) * (uniform(rng) < 0.5 ? -1 : 1);
+      const LonLat from = LonLat::fromDegrees(360*uniform(rng) - 180, lat);
+      const LonLat to = from.stepDirection(1 + 100000*uniform(rng), 2*M_PI*uniform(rng));
+      if (std::fabs(to.latDeg()) < b.lat0 || std::fabs(to.latDeg()) > b.lat1)
+        continue;
+
+      const double exact = from.distanceTo(to);
+      EXPECT_EQ(exact, from.distanceTo(to, DISTANCE_HAVERSINE));
+      if (b.equirectangular == 0)
+        EXPECT_EQ(exact, from.distanceTo(to, DISTANCE_EQUIRECTANGULAR));
+      else
+        EXPECT_NEAR(exact, from.distanceTo(to, DISTANCE_EQUIRECTANGULAR), exact*b.equirectangular);
+      EXPECT_NEAR(exact, from.distanceTo(to, DISTANCE_CHORD), exact*2e-5);
+      EXPECT_GE(exact*(1 + 1e-9), from.distanceTo(to, DISTANCE_CHORD));
+      EXPECT_NEAR(exact, from.distanceTo(to, DISTANCE_POLYNOMIAL), exact*1e-11);
+    }
+  }
+
+  for (int i = 0; i < 20000; ++i) {
+    const LonLat from = LonLat::fromDegrees(360*uniform(rng) - 180, 180*uniform(rng) - 90);
+    const LonLat to = LonLat::fromDegrees(720*uniform(rng) - 360, 180*uniform(rng) - 90);
+    const double exact = from.distanceTo(to);
+    EXPECT_NEAR(exact, from.distanceTo(to, DISTANCE_POLYNOMIAL), exact*2e-8);
+  }
+}
+
+TEST(LonLatTest, Chord2ForDistance)
+{
+  const PreparedLonLat pb(blindern), pf(fannarak);
+  const double d = blindern.distanceTo(fannarak);
+  EXPECT_LT(pb.chord2To(pf), chord2ForDistance(d + 1));
+  EXPECT_GT(pb.chord2To(pf), chord2ForDistance(d - 1));
+  EXPECT_EQ(0, chord2ForDistance(0));
+  EXPECT_LT(4, chord2ForDistance(M_PI * EARTH_RADIUS_M));
+}
+
+TEST(MiCoordinatesTest, IsCloserThan)
+{
+  miCoordinates bl(BLINDERN_LON, BLINDERN_LAT);
+  const miCoordinates fa(FANNARAK_LON, FANNARAK_LAT);
+  ASSERT_EQ(232, bl.distance(fa));
+  EXPECT_FALSE(bl.isCloserThan(fa, 231));
+  EXPECT_TRUE(bl.isCloserThan(fa, 232));
+  EXPECT_TRUE(bl.isCloserThan(fa, 20000));
+  EXPECT_FALSE(bl.isCloserThan(fa, 0));
+  EXPECT_TRUE(bl.isCloserThan(bl, 0));
+}
+
+TEST(MiCoordinatesTest, Compare)
+{
+  // these used to compare as equal
+  const miCoordinates a(10000, 0), b(0, 100);
+  EXPECT_NE(a, b);
+  EXPECT_TRUE(a > b);
+  EXPECT_TRUE(b < a);
+  EXPECT_FALSE(a < b);
+
+  // longitude first, then latitude
+  EXPECT_LT(miCoordinates(-10.5f, 80.0f), miCoordinates(-10.25f, -80.0f));
+  EXPECT_LT(miCoordinates(5.0f, -60.5f), miCoordinates(5.0f, -60.25f));
+  EXPECT_LT(miCoordinates(-179.9f, 0.0f), miCoordinates(179.9f, 0.0f));
+
+  EXPECT_EQ(miCoordinates(10.5f, 60.25f), miCoordinates(coor(10.5f), coor(60.25f)));
+  EXPECT_EQ(miCoordinates(10.5f, 60.25f).key(), miCoordinates(coor(10.5f), coor(60.25f)).key());
+  EXPECT_NE(miCoordinates(10.5f, 60.25f).key(), miCoordinates(60.25f, 10.5f).key());
+
+  const std::hash<miCoordinates> h;
+  EXPECT_EQ(h(miCoordinates(10.5f, 60.25f)), h(miCoordinates(103000, 601500)));
+
+  EXPECT_TRUE(coor(10.5f) < coor(10.51f));
+  EXPECT_TRUE(coor(-10.5f) < coor(-10.49f));
+  EXPECT_TRUE(coor(-10.5f) == coor(-10.5f));
+  EXPECT_TRUE(coor(-10.5f) >= coor(-10.5f));
+  EXPECT_TRUE(coor(-10.5f) <= coor(-10.5f));
+}
+
+TEST(MiCoordinatesTest, EncodeDecode)
+{
+  const miCoordinates c(coor(-10.5f), coor(59.99f));
+  EXPECT_EQ("-10:-3000:59:5940", c.encode());
+
+  char buffer[miCoordinates::ENCODED_MAX_SIZE];
+  const size_t n = c.encode(buffer, sizeof(buffer));
+  EXPECT_EQ(c.encode(), std::string(buffer, n));
+  EXPECT_EQ(0u, c.encode(buffer, 5));
+
+  coor lon, lat;
+  lon.deg = lat.deg = std::numeric_limits<int>::min();
+  lon.cmin = lat.cmin = std::numeric_limits<int>::min();
+  const miCoordinates extreme(lon, lat);
+  EXPECT_EQ(miCoordinates::ENCODED_MAX_SIZE, extreme.encode(buffer, sizeof(buffer)));
+
+  miCoordinates d;
+  EXPECT_TRUE(d.decode("-10:-3000:59:5940"));
+  EXPECT_EQ(c, d);
+  EXPECT_TRUE(d.decode(std::string("+1:2:3:4")));
+  EXPECT_EQ(1, d.Lon().deg);
+  EXPECT_EQ(4, d.Lat().cmin);
+
+  EXPECT_FALSE(d.decode("1:2:3"));
+  EXPECT_FALSE(d.decode("1:2:3:4:5"));
+  EXPECT_FALSE(d.decode("1:2:x:4"));
+  EXPECT_FALSE(d.decode("1:2: 3:4"));
+  EXPECT_FALSE(d.decode("1:2:3:"));
+  EXPECT_FALSE(d.decode("1:2:3:99999999999"));
+  EXPECT_FALSE(d.decode(""));
+  // failed decodes leave the coordinates unchanged
+  EXPECT_EQ(1, d.Lon().deg);
+
+  std::vector<miCoordinates> decoded;
+  EXPECT_EQ(1u, miCoordinates::decodeLines("1:2:3:4\n\n-5:-6:7:8\r\nbad\n9:10:11:12", decoded));
+  ASSERT_EQ(3u, decoded.size());
+  EXPECT_EQ("-5:-6:7:8", decoded[1].encode());
+  EXPECT_EQ("9:10:11:12", decoded[2].encode());
+}
+
+// the iostream formatting that sLon/sLat used to have
+static std::string streamFormat(const coor& c, char hemisphere)
+{
+  std::ostringstream out;
+  out << std::abs(c.deg) << "° " << std::fabs(float(c.cmin)/100) << "'" << hemisphere;
+  return out.str();
+}
+
+TEST(MiCoordinatesTest, Format)
+{
+  const miCoordinates c(-110500, 591950);
+  EXPECT_EQ("11° 5'W", c.sLon());
+  EXPECT_EQ("59° 19.5'N", c.sLat());
+  EXPECT_EQ("11° 5'W : 59° 19.5'N", c.str());
+
+  std::ostringstream out;
+  out << c;
+  EXPECT_EQ(c.str(), out.str());
+
+  char buffer[miCoordinates::STR_MAX_SIZE];
+  EXPECT_EQ(c.str().size(), c.str(buffer, c.str().size()));
+  EXPECT_EQ(0, c.str(buffer, c.str().size() - 1));
+  EXPECT_EQ(0, c.sLat(buffer, 4));
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> lon(-1800000, 1800000), lat(-900000, 900000), cmin(0, 5999);
+  for (int i = 0; i < 10000; ++i) {
+    const int ilon = lon(rng) / 10000 * 10000 + cmin(rng) * (i % 2 ? 1 : -1);
+    const miCoordinates r(ilon, lat(rng) / 10000 * 10000 + cmin(rng));
+    ASSERT_EQ(streamFormat(r.Lon(), r.iLon() < 0 ? 'W' : 'E'), r.sLon()) << ilon;
+    ASSERT_EQ(streamFormat(r.Lat(), r.iLat() < 0 ? 'S' : 'N'), r.sLat());
+  }
+}
+
+TEST(MiCoordinatesTest, Radians)
+{
+  const miCoordinates c(103000, -601501);
+  EXPECT_NEAR(d2r(10.5), c.rLon(), 1e-15);
+  EXPECT_NEAR(d2r(-(60 + 15.01/60)), c.rLat(), 1e-15);
+  EXPECT_EQ(c.rLon(), c.lonLat().lon());
+  EXPECT_EQ(c.rLat(), c.lonLat().lat());
+}
+
+TEST(MiPreparedCoordinatesTest, Queries)
+{
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> lon(-1795959, 1795959), lat(-895959, 895959);
+  std::vector<miCoordinates> coordinates;
+  for (int i = 0; i < 200; ++i)
+    coordinates.push_back(miCoordinates(lon(rng) / 10000 * 10000 + lon(rng) % 6000,
+            lat(rng) / 10000 * 10000 + lat(rng) % 6000));
+  coordinates.push_back(coordinates.front());
+
+  for (std::size_t i = 1; i < coordinates.size(); ++i) {
+    const miCoordinates& a = coordinates[i-1];
+    miCoordinates b = coordinates[i];
+    const miPreparedCoordinates pa(a), pb(b);
+    EXPECT_EQ(a, pa.coordinates());
+    EXPECT_EQ(a.rLat(), pa.rLat());
+    EXPECT_NEAR(a.distanceTo(b), pa.distanceTo(pb), 1e-3);
+    EXPECT_NEAR(a.distanceTo(b), pa.distanceTo(b), 1e-3);
+    EXPECT_NEAR(a.bearingToR(b), pa.bearingToR(pb), 1e-9);
+    const int km = a.distance(b);
+    EXPECT_TRUE(pa.isCloserThan(pb, km + 1));
+    EXPECT_FALSE(pa.isCloserThan(pb, km - 2));
+    EXPECT_EQ(b.isCloserThan(a, km / 2), pb.isCloserThan(pa, km / 2));
+  }
+
+  const miPreparedCoordinates p(coordinates.front());
+  EXPECT_TRUE(p.isCloserThan(p, 0));
+  EXPECT_FALSE(p.isCloserThan(p, -1));
+  EXPECT_EQ(0, p.distance(p));
+}
@@ -0,0 +1,127 @@
+#include "miGeodesic.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+static double d2r(double degrees)
+{
+  return degrees * M_PI / 180;
+}
+
+static double dms2r(int deg, int min, double sec)
+{
+  const double d = std::abs(deg) + (min/60.0) + (sec/3600.0);
+  return d2r(deg < 0 ? -d : d);
+}
+
+// Vincenty's test case: Flinders Peak to Buninyong
+static const LonLat flinders(dms2r(144,25,29.52440), dms2r(-37,57,3.72030));
+static const LonLat buninyong(dms2r(143,55,35.38390), dms2r(-37,39,10.15610));
+static const double FLINDERS_BUNINYONG_M = 54972.271;
+static const double FLINDERS_AZI1 = dms2r(306,52,5.37);
+static const double FLINDERS_AZI2 = dms2r(127,10,25.07) + M_PI;
+
+TEST(MiGeodesicTest, Inverse)
+{
+  const miGeodesic g;
+  double distance, azi1, azi2;
+  ASSERT_TRUE(g.inverse(flinders, buninyong, distance, azi1, azi2));
+  EXPECT_NEAR(FLINDERS_BUNINYONG_M, distance, 1e-3);
+  EXPECT_NEAR(FLINDERS_AZI1, azi1 + 2*M_PI, 1e-6);
+  EXPECT_NEAR(FLINDERS_AZI2, azi2 + 2*M_PI, 1e-6);
+
+  // quarter meridian on WGS84
+  EXPECT_NEAR(10001965.729, g.distance(LonLat::fromDegrees(10, 0), LonLat::fromDegrees(10, 90)), 1e-3);
+  // along the equator
+  EXPECT_NEAR(WGS84_A * d2r(20), g.distance(LonLat::fromDegrees(-10, 0), LonLat::fromDegrees(10, 0)), 1e-3);
+
+  EXPECT_EQ(0, g.distance(flinders, flinders));
+}
+
+TEST(MiGeodesicTest, Antipodal)
+{
+  const miGeodesic g;
+  // half a meridian on WGS84, the shortest way to the antipode off the equator
+  const double HALF_MERIDIAN = 2*10001965.729;
+  EXPECT_NEAR(HALF_MERIDIAN, g.distance(LonLat::fromDegrees(0, 0), LonLat::fromDegrees(180, 0)), 1e-3);
+  EXPECT_NEAR(HALF_MERIDIAN, g.distance(LonLat::fromDegrees(0, 10), LonLat::fromDegrees(180, -10)), 1e-3);
+  EXPECT_NEAR(HALF_MERIDIAN, g.distance(LonLat::fromDegrees(5, 80), LonLat::fromDegrees(-175, -80)), 1e-3);
+
+  // not along the equator, which would be WGS84_A*pi*179.5/180
+  const double d = g.distance(LonLat::fromDegrees(0, 0), LonLat::fromDegrees(179.5, 0));
+  EXPECT_LT(d, WGS84_A * d2r(179.5));
+  EXPECT_NEAR(19980861.909, d, 1e-3);
+
+  // nearly antipodal, from Karney's GeographicLib documentation
+  double distance, azi1, azi2;
+  ASSERT_TRUE(g.inverse(LonLat::fromDegrees(174.81, -41.32), LonLat::fromDegrees(-5.50, 40.96), distance, azi1, azi2));
+  EXPECT_NEAR(19959679.267354, distance, 1e-6);
+  EXPECT_NEAR(d2r(161.067669986160), azi1, 1e-12);
+  EXPECT_NEAR(d2r(18.825195123247), azi2, 1e-12);
+
+  // more nearly antipodal points
+  const double points[][4] = {
+    { 0, 0.5, 179.7, -0.5 },
+    { 0, 0, 179.5, 0 },
+    { 0, 0, 179.4, 0 },
+    { 10, -30, -170.2, 29.9 },
+    { -20, 45, 159.9, -45.1 },
+    { 0, 0, -179.8, 0.1 },
+  };
+  for (const double* p : points) {
+    const LonLat from = LonLat::fromDegrees(p[0], p[1]), to = LonLat::fromDegrees(p[2], p[3]);
+    double distance, azi1, azi2, azi2back;
+    ASSERT_TRUE(g.inverse(from, to, distance, azi1, azi2));
+    EXPECT_GT(distance, 19.9e6);
+    EXPECT_LT(distance, HALF_MERIDIAN + 1e-3);
+
+    const LonLat back = miGeodesicLine(from, azi1).position(distance, &azi2back);
+    EXPECT_NEAR(0, g.distance(back, to), 1e-3);
+    EXPECT_NEAR(0, std::remainder(azi2 - azi2back, 2*M_PI), 1e-6);
+
+    // the same distance in the other direction
+    EXPECT_NEAR(distance, g.distance(to, from), 1e-3);
+  }
+}
+
+TEST(MiGeodesicTest, Direct)
+{
+  const miGeodesic g;
+  const LonLat b = g.direct(flinders, FLINDERS_AZI1, FLINDERS_BUNINYONG_M);
+  EXPECT_NEAR(buninyong.lon(), b.lon(), 1e-9);
+  EXPECT_NEAR(buninyong.lat(), b.lat(), 1e-9);
+
+  double azi2;
+  miGeodesicLine(flinders, FLINDERS_AZI1).position(FLINDERS_BUNINYONG_M, &azi2);
+  EXPECT_NEAR(FLINDERS_AZI2, azi2 + 2*M_PI, 1e-6);
+}
+
+TEST(MiGeodesicTest, Roundtrip)
+{
+  const LonLat origin = LonLat::fromDegrees(10.72, 59.94);
+  const miGeodesicOrigin go(origin);
+  const miGeodesic g;
+
+  std::vector<double> lons, lats;
+  for (int lat = -80; lat <= 80; lat += 20) {
+    for (int lon = -170; lon <= 170; lon += 40) {
+      lons.push_back(d2r(lon));
+      lats.push_back(d2r(lat));
+    }
+  }
+  std::vector<double> distances(lons.size());
+  go.distancesTo(&lons[0], &lats[0], lons.size(), &distances[0]);
+
+  for (size_t i = 0; i < lons.size(); ++i) {
+    const LonLat to(lons[i], lats[i]);
+    double distance, azi1, azi2;
+    ASSERT_TRUE(g.inverse(origin, to, distance, azi1, azi2));
+    EXPECT_EQ(distance, distances[i]);
+    EXPECT_NEAR(origin.distanceTo(to), distance, distance*0.005);
+
+    const LonLat back = miGeodesicLine(origin, azi1).position(distance);
+    EXPECT_NEAR(0, g.distance(back, to), 1e-3);
+  }
+}
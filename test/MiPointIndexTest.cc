@@ -0,0 +1,199 @@
+#include "miPointIndex.h"
+#include "miPositionIndex.h"
+#include "miProximity.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<LonLat> randomPoints(size_t n, unsigned seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> lon(-M_PI, M_PI), z(-1, 1);
+  std::vector<LonLat> points;
+  for (size_t i = 0; i < n; ++i)
+    points.push_back(LonLat(lon(rng), std::asin(z(rng))));
+  return points;
+}
+
+// indices sorted by distance, then index
+std::vector<size_t> bruteForce(const std::vector<LonLat>& points, const LonLat& p)
+{
+  std::vector<std::pair<double, size_t> > d;
+  const PreparedLonLat pp(p);
+  for (size_t i = 0; i < points.size(); ++i)
+    d.push_back(std::make_pair(pp.chord2To(PreparedLonLat(points[i])), i));
+  std::sort(d.begin(), d.end());
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < d.size(); ++i)
+    indices.push_back(d[i].second);
+  return indices;
+}
+
+} // namespace
+
+TEST(MiPointIndexTest, Nearest)
+{
+  const std::vector<LonLat> points = randomPoints(2000, 1);
+  const miPointIndex index(points);
+  ASSERT_EQ(points.size(), index.size());
+
+  const std::vector<LonLat> queries = randomPoints(50, 2);
+  std::vector<size_t> found;
+  std::vector<double> distances;
+  for (size_t q = 0; q < queries.size(); ++q) {
+    const std::vector<size_t> expected = bruteForce(points, queries[q]);
+    index.nearest(queries[q], 7, found, &distances);
+    ASSERT_EQ(7u, found.size());
+    for (size_t i = 0; i < found.size(); ++i) {
+      EXPECT_EQ(expected[i], found[i]);
+      EXPECT_NEAR(queries[q].distanceTo(points[found[i]]), distances[i], 1e-3);
+    }
+  }
+
+  index.nearest(queries[0], points.size() + 5, found);
+  EXPECT_EQ(points.size(), found.size());
+
+  index.nearest(queries[0], 0, found);
+  EXPECT_TRUE(found.empty());
+}
+
+TEST(MiPointIndexTest, NearestAccepted)
+{
+  const std::vector<LonLat> points = randomPoints(1000, 3);
+  const miPointIndex index(points);
+
+  const std::vector<LonLat> queries = randomPoints(20, 4);
+  for (size_t q = 0; q < queries.size(); ++q) {
+    const std::vector<size_t> expected = bruteForce(points, queries[q]);
+    size_t i = 0;
+    while (expected[i] % 7 != 3)
+      ++i;
+
+    size_t found;
+    double distance;
+    ASSERT_TRUE(index.nearest(queries[q], [](size_t idx) { return idx % 7 == 3; }, found, distance));
+    EXPECT_EQ(expected[i], found);
+  }
+
+  size_t found;
+  double distance;
+  EXPECT_FALSE(index.nearest(queries[0], [](size_t) { return false; }, found, distance));
+}
+
+TEST(MiPointIndexTest, Within)
+{
+  const std::vector<LonLat> points = randomPoints(2000, 5);
+  const miPointIndex index(points);
+  const std::vector<LonLat> queries = randomPoints(20, 6);
+  const double radius = 800000;
+
+  std::vector<size_t> found;
+  for (size_t q = 0; q < queries.size(); ++q) {
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < points.size(); ++i)
+      if (queries[q].distanceTo(points[i]) <= radius)
+        expected.push_back(i);
+    index.within(queries[q], radius, found);
+    EXPECT_EQ(expected, found);
+  }
+
+  index.within(queries[0], 2.1e7, found);
+  EXPECT_EQ(points.size(), found.size());
+}
+
+TEST(MiPositionIndexTest, Nearest)
+{
+  std::vector<miPosition> positions;
+  positions.push_back(miPosition(miCoordinates(10.72f, 59.94f), 1492, 18700, "Blindern", 94, 1, "synop"));
+  positions.push_back(miPosition(miCoordinates(7.91f, 61.52f), 1376, 55700, "Fannaraken", 2062, 2, "synop"));
+  positions.push_back(miPosition(miCoordinates(10.78f, 59.91f), 0, 18020, "Oslo", 10, 0, "precip"));
+  positions.push_back(miPosition(miCoordinates(5.33f, 60.38f), 1317, 50540, "Bergen", 12, 2, "synop"));
+  const miPositionIndex index(positions);
+
+  const miCoordinates oslo(10.75f, 59.91f);
+  size_t found;
+  double distance;
+  ASSERT_TRUE(index.nearest(oslo, found, distance));
+  EXPECT_EQ(2u, found);
+  EXPECT_NEAR(oslo.distanceTo(positions[2].Coordinates()), distance, 1);
+
+  ASSERT_TRUE(index.nearestInGroup(oslo, "synop", found, distance));
+  EXPECT_EQ(0u, found);
+
+  ASSERT_TRUE(index.nearestWithPriority(oslo, 2, found, distance));
+  EXPECT_EQ(1u, found);
+
+  EXPECT_FALSE(index.nearestInGroup(oslo, "metar", found, distance));
+
+  std::vector<size_t> indices;
+  index.within(oslo, 10000, indices);
+  ASSERT_EQ(2u, indices.size());
+  EXPECT_EQ(0u, indices[0]);
+  EXPECT_EQ(2u, indices[1]);
+}
+
+TEST(MiProximityTest, PairsWithin)
+{
+  const std::vector<LonLat> points = randomPoints(1500, 7);
+  const double radius = 300000;
+
+  std::vector<std::pair<size_t, size_t> > expected, found;
+  for (size_t i = 0; i < points.size(); ++i)
+    for (size_t j = i + 1; j < points.size(); ++j)
+      if (points[i].distanceTo(points[j]) <= radius)
+        expected.push_back(std::make_pair(i, j));
+
+  findPairsWithin(points, radius, [&](size_t i, size_t j, double distance) {
+      EXPECT_LT(i, j);
+      EXPECT_NEAR(points[i].distanceTo(points[j]), distance, 1e-3);
+      found.push_back(std::make_pair(i, j));
+    });
+  std::sort(found.begin(), found.end());
+  EXPECT_EQ(expected, found);
+
+  miAdjacency adjacency;
+  findNeighboursWithin(points, radius, adjacency);
+  ASSERT_EQ(points.size(), adjacency.size());
+  EXPECT_EQ(2*expected.size(), adjacency.neighbours.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    std::vector<size_t> neighbours;
+    for (size_t j = 0; j < points.size(); ++j)
+      if (j != i && points[i].distanceTo(points[j]) <= radius)
+        neighbours.push_back(j);
+    const std::vector<size_t> row(adjacency.neighbours.begin() + adjacency.offsets[i],
+        adjacency.neighbours.begin() + adjacency.offsets[i+1]);
+    EXPECT_EQ(neighbours, row);
+  }
+}
+
+TEST(MiProximityTest, KnnJoin)
+{
+  const std::vector<LonLat> points = randomPoints(3000, 8);
+  const std::vector<LonLat> queries = randomPoints(700, 9);
+  const size_t k = 5;
+
+  std::vector<size_t> indices1, indices4;
+  std::vector<double> distances1, distances4;
+  ASSERT_EQ(k, knnJoin(queries, points, k, indices1, distances1, 1));
+  ASSERT_EQ(k, knnJoin(queries, points, k, indices4, distances4, 4));
+  EXPECT_EQ(indices1, indices4);
+  EXPECT_EQ(distances1, distances4);
+
+  ASSERT_EQ(queries.size()*k, indices1.size());
+  for (size_t q = 0; q < queries.size(); q += 37) {
+    const std::vector<size_t> expected = bruteForce(points, queries[q]);
+    for (size_t i = 0; i < k; ++i)
+      EXPECT_EQ(expected[i], indices1[q*k + i]);
+  }
+
+  std::vector<LonLat> few(points.begin(), points.begin() + 3);
+  EXPECT_EQ(3u, knnJoin(queries, few, k, indices1, distances1));
+  EXPECT_EQ(queries.size()*3, indices1.size());
+}
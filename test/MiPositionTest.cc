@@ -0,0 +1,682 @@
+#include "miConcurrentRegistry.h"
+#include "miPositionLoader.h"
+#include "miPositionTable.h"
+#include "miStationCatalog.h"
+#include "miStationRegistry.h"
+#include "miStringPool.h"
+#include "miSymbol.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static std::string catalog(int count)
+{
+  std::ostringstream text;
+  text << "# synop;dbkey;name;lon;lat;height;priority;group;icao\n";
+  for (int i = 0; i < count; ++i) {
+    text << (1000 + i) << ';' << i << ";station " << i << ';'
+         << (i % 359 - 179) << '.' << (i % 10) << ';' << (i % 179 - 89) << ".5;"
+         << (i % 1000) << ';' << (i % 3) << ';' << (i % 2 ? "synop" : "metar")
+         << ';' << "E" << char('A' + i % 26) << char('A' + i / 26 % 26) << 'X' << '\n';
+    if (i % 997 == 0)
+      text << "\n";
+  }
+  return text.str();
+}
+
+TEST(MiPositionLoaderTest, ParseLine)
+{
+  const miPositionLoader loader;
+  miPosition p;
+  ASSERT_TRUE(loader.parseLine("1492;18700;Oslo - Blindern;10.72;59.94;94;1;synop;ENBL", p));
+  EXPECT_EQ(1492, p.Synop());
+  EXPECT_EQ(18700, p.DbKey());
+  EXPECT_EQ("Oslo - Blindern", p.Name());
+  EXPECT_EQ(miCoordinates(10.72f, 59.94f), p.Coordinates());
+  EXPECT_EQ(94, p.height());
+  EXPECT_EQ(1, p.Priority());
+  EXPECT_EQ("synop", p.Group());
+  EXPECT_EQ("ENBL", p.icaoID());
+
+  ASSERT_TRUE(loader.parseLine("1;2;x;-1.5;+2", p));
+  EXPECT_EQ(miCoordinates(-1.5f, 2.0f), p.Coordinates());
+  EXPECT_EQ(0, p.height());
+  EXPECT_EQ("", p.Group());
+  EXPECT_EQ("", p.icaoID());
+
+  EXPECT_FALSE(loader.parseLine("1;2;x;-1.5", p));
+  EXPECT_FALSE(loader.parseLine("1;2;x;-1.5;95", p));
+  EXPECT_FALSE(loader.parseLine("1;2;x;a;2", p));
+  EXPECT_FALSE(loader.parseLine("1;2;x;1;2;h", p));
+  EXPECT_FALSE(loader.parseLine("1;2;x;1;2;3;4;g;i;extra", p));
+  EXPECT_FALSE(loader.parseLine("1;2;x;nan;10", p));
+  EXPECT_FALSE(loader.parseLine("1;2;x;10;nan", p));
+  EXPECT_FALSE(loader.parseLine("1;2;x;inf;10", p));
+  EXPECT_FALSE(loader.parseLine("1;2;x;10;-inf", p));
+
+  const miPositionLoader tsv('\t');
+  ASSERT_TRUE(tsv.parseLine("1\t2\ta;b\t3\t4", p));
+  EXPECT_EQ("a;b", p.Name());
+}
+
+TEST(MiPositionLoaderTest, Load)
+{
+  const miPositionLoader loader;
+  std::vector<miPosition> positions(1);
+  const std::size_t bad = loader.load("# comment\r\n"
+      "1;2;first;3;4\r\n"
+      "\n"
+      "broken\n"
+      "5;6;second;7;8;9", positions);
+  EXPECT_EQ(1, bad);
+  ASSERT_EQ(3, positions.size());
+  EXPECT_EQ("first", positions[1].Name());
+  EXPECT_EQ("second", positions[2].Name());
+  EXPECT_EQ(9, positions[2].height());
+
+  positions.clear();
+  EXPECT_EQ(0, loader.load("", positions));
+  EXPECT_TRUE(positions.empty());
+}
+
+TEST(MiPositionLoaderTest, LoadParallel)
+{
+  const std::string text = catalog(20000);
+
+  std::vector<miPosition> single, parallel;
+  EXPECT_EQ(0, miPositionLoader(';', 1).load(text, single));
+  EXPECT_EQ(0, miPositionLoader(';', 7).load(text, parallel));
+  ASSERT_EQ(20000, single.size());
+  ASSERT_EQ(single.size(), parallel.size());
+  for (std::size_t i = 0; i < single.size(); ++i) {
+    ASSERT_EQ(int(1000 + i), parallel[i].Synop());
+    ASSERT_EQ(single[i].Name(), parallel[i].Name());
+    ASSERT_EQ(single[i].Coordinates(), parallel[i].Coordinates());
+    ASSERT_EQ(single[i].icaoID(), parallel[i].icaoID());
+  }
+}
+
+TEST(MiPositionLoaderTest, LoadFile)
+{
+  char filename[] = "/tmp/pudatatypes_positions_XXXXXX";
+  const int fd = mkstemp(filename);
+  ASSERT_GE(fd, 0);
+  const std::string text = catalog(100);
+  ASSERT_EQ(ssize_t(text.size()), write(fd, text.data(), text.size()));
+  close(fd);
+
+  const miPositionLoader loader;
+  std::vector<miPosition> positions;
+  std::size_t bad = 1;
+  EXPECT_TRUE(loader.loadFile(filename, positions, &bad));
+  EXPECT_EQ(0, bad);
+  EXPECT_EQ(100, positions.size());
+  std::remove(filename);
+
+  EXPECT_FALSE(loader.loadFile(filename, positions));
+}
+
+TEST(MiPositionTest, FormatCoordinates)
+{
+  std::vector<miPosition> positions;
+  positions.push_back(miPosition(miCoordinates(-110500, 591950), 1, 1, "a"));
+  positions.push_back(miPosition(miCoordinates(103000, -601500), 2, 2, "b"));
+
+  std::string text;
+  std::vector<std::size_t> offsets;
+  formatCoordinates(positions, text, offsets);
+  ASSERT_EQ(3, offsets.size());
+  for (std::size_t i = 0; i < positions.size(); ++i)
+    EXPECT_EQ(positions[i].Coordinates().str(), text.substr(offsets[i], offsets[i+1] - offsets[i]));
+  EXPECT_EQ(text.size(), offsets.back());
+
+  formatCoordinates(std::vector<miPosition>(), text, offsets);
+  EXPECT_TRUE(text.empty());
+  EXPECT_EQ(1, offsets.size());
+}
+
+TEST(MiStringPoolTest, Intern)
+{
+  miStringPool pool;
+  EXPECT_EQ(0, pool.size());
+  EXPECT_EQ(miStringPool::NONE, pool.find("synop"));
+
+  const miStringPool::id_t synop = pool.intern("synop");
+  const miStringPool::id_t empty = pool.intern("");
+  EXPECT_EQ(synop, pool.intern(std::string("syn") + "op"));
+  EXPECT_NE(synop, empty);
+  EXPECT_EQ(synop, pool.find("synop"));
+  EXPECT_EQ("", pool.str(empty));
+
+  std::vector<std::string> strings;
+  for (int i = 0; i < 5000; ++i)
+    strings.push_back("station " + std::to_string(i));
+  std::vector<miStringPool::id_t> ids;
+  for (std::size_t i = 0; i < strings.size(); ++i)
+    ids.push_back(pool.intern(strings[i]));
+  ASSERT_EQ(strings.size() + 2, pool.size());
+  for (std::size_t i = 0; i < strings.size(); ++i) {
+    ASSERT_EQ(ids[i], pool.find(strings[i]));
+    ASSERT_EQ(strings[i], pool.str(ids[i]));
+  }
+  EXPECT_EQ("synop", pool.str(synop));
+
+  pool.clear();
+  EXPECT_EQ(0, pool.size());
+  EXPECT_EQ(miStringPool::NONE, pool.find("synop"));
+}
+
+static std::vector<miPosition> randomPositions(int count)
+{
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> lon(-1795959, 1795959), lat(-895959, 895959), cmin(0, 5999);
+  const char* groups[] = { "synop", "metar", "ship" };
+  std::vector<miPosition> positions;
+  for (int i = 0; i < count; ++i) {
+    const int ilon = lon(rng) / 10000 * 10000, ilat = lat(rng) / 10000 * 10000;
+    const miCoordinates c(ilon + (ilon < 0 ? -1 : 1) * cmin(rng), ilat + (ilat < 0 ? -1 : 1) * cmin(rng));
+    positions.push_back(miPosition(c, 1000 + i, i, "station " + std::to_string(i), i % 100, i % 4, groups[i % 3]));
+    positions.back().setIcao(i % 2 ? "" : "E" + std::to_string(i));
+  }
+  return positions;
+}
+
+TEST(MiPositionTableTest, Rows)
+{
+  const std::vector<miPosition> positions = randomPositions(1000);
+  const miPositionTable table(positions);
+  ASSERT_EQ(positions.size(), table.size());
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    const miPositionTable::Row row = table[i];
+    const miPosition& p = positions[i];
+    ASSERT_EQ(p.Coordinates(), row.Coordinates());
+    ASSERT_EQ(p.Coordinates().str(), row.Coordinates().str());
+    ASSERT_EQ(p.lon(), row.lon());
+    ASSERT_EQ(p.Name(), row.Name());
+    ASSERT_EQ(p.Synop(), row.Synop());
+    ASSERT_EQ(p.DbKey(), row.DbKey());
+    ASSERT_EQ(p.height(), row.height());
+    ASSERT_EQ(p.Priority(), row.Priority());
+    ASSERT_EQ(p.Group(), row.Group());
+    ASSERT_EQ(p.icaoID(), row.icaoID());
+    const miPosition copy = row.position();
+    ASSERT_EQ(p.Name(), copy.Name());
+    ASSERT_EQ(p.icaoID(), copy.icaoID());
+  }
+  // names are unique, groups are shared
+  EXPECT_EQ(1000 + 3 + 500 + 1, table.strings().size());
+}
+
+TEST(MiPositionTableTest, Filters)
+{
+  std::vector<miPosition> positions = randomPositions(3000);
+  const miPositionTable table(positions);
+  const miCoordinates nw(-200000, 600000), se(300000, -100000), c(103000, 595600);
+
+  std::vector<std::size_t> rect, group, near, km;
+  table.inRect(nw, se, rect);
+  table.inGroup("metar", group);
+  table.within(c, 2000000, near);
+  table.withinKm(c, 1500, km);
+
+  std::vector<std::size_t> erect, egroup, enear, ekm;
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    if (positions[i].isInRect(nw, se))
+      erect.push_back(i);
+    if (positions[i].isGrp("metar"))
+      egroup.push_back(i);
+    if (positions[i].Coordinates().distanceTo(c) <= 2000000)
+      enear.push_back(i);
+    miCoordinates pc = positions[i].Coordinates();
+    if (pc.isCloserThan(c, 1500))
+      ekm.push_back(i);
+  }
+  EXPECT_FALSE(erect.empty());
+  EXPECT_EQ(erect, rect);
+  EXPECT_EQ(1000, group.size());
+  EXPECT_EQ(egroup, group);
+  EXPECT_FALSE(enear.empty());
+  EXPECT_EQ(enear, near);
+  EXPECT_EQ(ekm, km);
+
+  table.inGroup("none", group);
+  EXPECT_TRUE(group.empty());
+  table.withinKm(positions[7].Coordinates(), 0, km);
+  ASSERT_EQ(1, km.size());
+  EXPECT_EQ(7, km[0]);
+}
+
+TEST(MiStationRegistryTest, Find)
+{
+  std::vector<miPosition> positions = randomPositions(5000);
+  positions[10].setName("duplicate");
+  positions[20].setName("duplicate");
+  positions[30].setName("duplicate");
+  positions.push_back(positions[100]); // same synop, dbkey, icao and name
+  const miStationRegistry registry(positions);
+  ASSERT_EQ(positions.size(), registry.size());
+
+  for (std::size_t i = 0; i < 5000; ++i) {
+    if (i == 10 || i == 20 || i == 30)
+      continue;
+    ASSERT_EQ(i, registry.findSynop(1000 + i));
+    ASSERT_EQ(i == 0 ? miStationRegistry::NONE : i, registry.findDbKey(i));
+    ASSERT_EQ(i, registry.findName(positions[i].Name()));
+    if (i % 2)
+      continue;
+    ASSERT_EQ(i, registry.findIcao(positions[i].icaoID()));
+  }
+  EXPECT_EQ(miStationRegistry::NONE, registry.findSynop(999));
+  EXPECT_EQ(miStationRegistry::NONE, registry.findDbKey(-1));
+  EXPECT_EQ(miStationRegistry::NONE, registry.findIcao(""));
+  EXPECT_EQ(miStationRegistry::NONE, registry.findIcao("XXXX"));
+  EXPECT_EQ(miStationRegistry::NONE, registry.findName("synop"));
+
+  std::size_t row = registry.findName("duplicate");
+  EXPECT_EQ(10, row);
+  row = registry.next(miStationRegistry::NAME, row);
+  EXPECT_EQ(20, row);
+  row = registry.next(miStationRegistry::NAME, row);
+  EXPECT_EQ(30, row);
+  EXPECT_EQ(miStationRegistry::NONE, registry.next(miStationRegistry::NAME, row));
+
+  EXPECT_EQ(5000, registry.next(miStationRegistry::SYNOP, 100));
+  EXPECT_EQ(5000, registry.next(miStationRegistry::DBKEY, 100));
+  EXPECT_EQ(5000, registry.next(miStationRegistry::ICAO, 100));
+  EXPECT_EQ(miStationRegistry::NONE, registry.next(miStationRegistry::SYNOP, 5000));
+  EXPECT_EQ("station 100", registry[5000].Name());
+
+  // stations without synop and dbKey are only found by name
+  positions.push_back(miPosition());
+  positions.back().setName("no ids");
+  const miStationRegistry withoutIds(positions);
+  EXPECT_EQ(miStationRegistry::NONE, withoutIds.findSynop(0));
+  EXPECT_EQ(miStationRegistry::NONE, withoutIds.findDbKey(0));
+  EXPECT_EQ(5001, withoutIds.findName("no ids"));
+
+  const miStationRegistry empty;
+  EXPECT_EQ(miStationRegistry::NONE, empty.findSynop(0));
+  EXPECT_EQ(miStationRegistry::NONE, empty.findName(""));
+}
+
+TEST(MiPositionTest, SortPositions)
+{
+  const std::vector<miPosition> positions = randomPositions(5000);
+  const miCoordinates origo(103000, 595600);
+  const miPosition::sort_mode modes[] = { miPosition::sort_name, miPosition::sort_synop,
+      miPosition::sort_lat, miPosition::sort_lon, miPosition::sort_dbkey, miPosition::sort_distance };
+
+  for (miPosition::sort_mode mode : modes) {
+    std::vector<miPosition> expected = positions;
+    std::stable_sort(expected.begin(), expected.end(), miPositionLess(mode, origo));
+    for (unsigned int threads : { 0u, 1u, 4u }) {
+      std::vector<miPosition> sorted = positions;
+      sortPositions(sorted, mode, origo, threads);
+      ASSERT_EQ(expected.size(), sorted.size());
+      for (std::size_t i = 0; i < sorted.size(); ++i)
+        ASSERT_EQ(expected[i].DbKey(), sorted[i].DbKey()) << "mode " << mode << " threads " << threads;
+    }
+  }
+
+  // the old interface, for comparison
+  miPosition::setSortMode(miPosition::sort_synop);
+  std::vector<miPosition> expected = positions;
+  std::sort(expected.begin(), expected.end());
+  std::vector<miPosition> sorted = positions;
+  sortPositions(sorted, miPosition::sort_synop);
+  for (std::size_t i = 0; i < sorted.size(); ++i)
+    ASSERT_EQ(expected[i].Synop(), sorted[i].Synop());
+  miPosition::setSortMode(miPosition::sort_name);
+}
+
+TEST(MiPositionTest, SortConcurrently)
+{
+  const std::vector<miPosition> positions = randomPositions(20000);
+  std::vector<miPosition> byLat = positions, byName = positions;
+  std::thread lat([&]() { sortPositions(byLat, miPosition::sort_lat, miCoordinates(), 2); });
+  std::thread name([&]() { sortPositions(byName, miPosition::sort_name, miCoordinates(), 2); });
+  lat.join();
+  name.join();
+  EXPECT_TRUE(std::is_sorted(byLat.begin(), byLat.end(), miPositionLess(miPosition::sort_lat)));
+  EXPECT_TRUE(std::is_sorted(byName.begin(), byName.end(), miPositionLess(miPosition::sort_name)));
+}
+
+static std::string tempFilename()
+{
+  char filename[] = "/tmp/pudatatypes_catalog_XXXXXX";
+  const int fd = mkstemp(filename);
+  if (fd >= 0)
+    close(fd);
+  return filename;
+}
+
+static std::string readFile(const std::string& filename)
+{
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& filename, const std::string& content)
+{
+  std::ofstream out(filename.c_str(), std::ios::binary);
+  out.write(content.data(), content.size());
+}
+
+TEST(MiStationCatalogTest, WriteOpen)
+{
+  std::vector<miPosition> positions = randomPositions(3000);
+  positions[10].setName("duplicate");
+  positions[20].setName("duplicate");
+  positions.push_back(positions[100]);
+  positions.push_back(miPosition(miCoordinates(1795959, 0), 1, 1, "dateline east"));
+  positions.push_back(miPosition(miCoordinates(-1795959, 0), 2, 2, "dateline west"));
+  positions.push_back(miPosition(miCoordinates(0, 895959), 3, 3, "north pole"));
+  const miPositionTable table(positions);
+  const std::string filename = tempFilename();
+  std::string error;
+  ASSERT_TRUE(miStationCatalog::write(filename, table, &error)) << error;
+
+  miStationCatalog catalog;
+  ASSERT_TRUE(catalog.open(filename)) << catalog.error();
+  ASSERT_EQ(positions.size(), catalog.size());
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    const miPosition p = catalog.position(i);
+    ASSERT_EQ(positions[i].Coordinates(), p.Coordinates());
+    ASSERT_EQ(positions[i].Name(), catalog.name(i));
+    ASSERT_EQ(positions[i].Group(), catalog.group(i));
+    ASSERT_EQ(positions[i].icaoID(), catalog.icao(i));
+    ASSERT_EQ(positions[i].Synop(), catalog.synop(i));
+    ASSERT_EQ(positions[i].DbKey(), p.DbKey());
+    ASSERT_EQ(positions[i].height(), p.height());
+    ASSERT_EQ(positions[i].Priority(), p.Priority());
+  }
+
+  const miStationRegistry registry(table);
+  for (std::size_t i = 0; i < 3000; i += 7) {
+    ASSERT_EQ(registry.findSynop(positions[i].Synop()), catalog.findSynop(positions[i].Synop()));
+    ASSERT_EQ(registry.findDbKey(positions[i].DbKey()), catalog.findDbKey(positions[i].DbKey()));
+    ASSERT_EQ(registry.findName(positions[i].Name()), catalog.findName(positions[i].Name()));
+    ASSERT_EQ(registry.findIcao(positions[i].icaoID()), catalog.findIcao(positions[i].icaoID()));
+  }
+  const miStationCatalog::Rows dup = catalog.rowsWithName("duplicate");
+  ASSERT_EQ(2, dup.size());
+  EXPECT_EQ(10, dup.begin()[0]);
+  EXPECT_EQ(20, dup.begin()[1]);
+  EXPECT_EQ(2, catalog.rowsWithSynop(1100).size());
+  EXPECT_EQ(miStationCatalog::NONE, catalog.findSynop(999));
+  EXPECT_EQ(miStationCatalog::NONE, catalog.findIcao(""));
+  EXPECT_EQ(miStationCatalog::NONE, catalog.findName("nobody"));
+
+  const miCoordinates centres[] = { miCoordinates(103000, 595600), miCoordinates(1790000, 100000),
+      miCoordinates(-1790000, -100000), miCoordinates(0, 880000), miCoordinates(0, -890000) };
+  const double radii[] = { 0, 100000, 1000000, 5000000, 30000000 };
+  for (const miCoordinates& c : centres) {
+    for (double radius : radii) {
+      std::vector<std::size_t> expected, found;
+      table.within(c, radius, expected);
+      catalog.within(c, radius, found);
+      ASSERT_EQ(expected, found) << c << " " << radius;
+    }
+  }
+  std::vector<std::size_t> found;
+  catalog.within(positions[3001].Coordinates(), 1000000, found);
+  EXPECT_NE(found.end(), std::find(found.begin(), found.end(), 3002));
+
+  catalog.close();
+  std::remove(filename.c_str());
+}
+
+TEST(MiStationCatalogTest, Validate)
+{
+  const miPositionTable table(randomPositions(100));
+  const std::string filename = tempFilename();
+  ASSERT_TRUE(miStationCatalog::write(filename, table));
+  const std::string good = readFile(filename);
+
+  miStationCatalog catalog;
+  ASSERT_TRUE(catalog.open(filename));
+  EXPECT_TRUE(catalog.error().empty());
+
+  writeFile(filename, good.substr(0, good.size() - 8));
+  EXPECT_FALSE(catalog.open(filename));
+  EXPECT_FALSE(catalog.isOpen());
+  EXPECT_EQ("truncated file", catalog.error());
+
+  std::string bad = good;
+  bad[0] = 'X';
+  writeFile(filename, bad);
+  EXPECT_FALSE(catalog.open(filename));
+  EXPECT_EQ("not a station catalog", catalog.error());
+
+  bad = good;
+  bad[8] = 2; // version
+  writeFile(filename, bad);
+  EXPECT_FALSE(catalog.open(filename));
+
+  // flipping any byte of the indices or string table must be detected or harmless
+  for (std::size_t i = 40; i < good.size(); i += 13) {
+    bad = good;
+    bad[i] = char(bad[i] ^ 0x5a);
+    writeFile(filename, bad);
+    if (catalog.open(filename)) {
+      // check that queries stay in bounds
+      for (std::size_t r = 0; r < catalog.size(); ++r) {
+        const std::size_t f = catalog.findDbKey(catalog.dbKey(r));
+        ASSERT_TRUE(f == miStationCatalog::NONE || f < catalog.size());
+        catalog.position(r);
+      }
+    }
+  }
+
+  writeFile(filename, "");
+  EXPECT_FALSE(catalog.open(filename));
+  std::remove(filename.c_str());
+  EXPECT_FALSE(catalog.open(filename));
+}
+
+TEST(MiStationCatalogTest, ConcurrentWriters)
+{
+  const std::string filename = tempFilename();
+  std::vector<miPositionTable> tables;
+  for (int t = 0; t < 4; ++t)
+    tables.push_back(miPositionTable(randomPositions(500 + 100*t)));
+
+  std::atomic<int> ok(0);
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.push_back(std::thread([&, t]() {
+          for (int i = 0; i < 5; ++i)
+            ok += miStationCatalog::write(filename, tables[t]);
+        }));
+  }
+  for (std::thread& w : writers)
+    w.join();
+  EXPECT_EQ(20, ok);
+
+  // the last writer wins, with a complete catalog
+  miStationCatalog catalog;
+  ASSERT_TRUE(catalog.open(filename)) << catalog.error();
+  EXPECT_EQ(0, catalog.size() % 100);
+  catalog.close();
+
+  // no temporary files are left behind
+  const std::string dir = filename.substr(0, filename.rfind('/'));
+  const std::string pattern = filename.substr(dir.size() + 1) + ".";
+  DIR* d = opendir(dir.c_str());
+  ASSERT_TRUE(d != 0);
+  while (const dirent* e = readdir(d))
+    EXPECT_NE(0, std::string(e->d_name).compare(0, pattern.size(), pattern)) << e->d_name;
+  closedir(d);
+  std::remove(filename.c_str());
+}
+
+TEST(MiStationCatalogTest, Umask)
+{
+  const std::string filename = tempFilename();
+  const mode_t mask = ::umask(027);
+  const bool written = miStationCatalog::write(filename, miPositionTable(randomPositions(10)));
+  ::umask(mask);
+  ASSERT_TRUE(written);
+
+  struct stat st;
+  ASSERT_EQ(0, ::stat(filename.c_str(), &st));
+  EXPECT_EQ(0640, st.st_mode & 0777);
+  std::remove(filename.c_str());
+}
+
+TEST(MiSymbolTest, Intern)
+{
+  const miSymbol empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ("", empty.str());
+  EXPECT_EQ(empty, miSymbol(""));
+
+  const miSymbol a("miSymbolTest a"), b(std::string("miSymbolTest ") + "a"), c("miSymbolTest c");
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ("miSymbolTest a", a.str());
+  EXPECT_EQ("miSymbolTest c", c.str());
+  const std::string longName(100000, 'x');
+  EXPECT_EQ(longName, miSymbol(longName).str());
+
+  // concurrent interning of overlapping strings gives the same symbols
+  const std::size_t before = miSymbol::count();
+  std::vector<std::vector<miSymbol>> symbols(4);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < symbols.size(); ++t)
+    threads.push_back(std::thread([&symbols, t]() {
+          for (int i = 0; i < 20000; ++i)
+            symbols[t].push_back(miSymbol("miSymbolTest " + std::to_string((i * (t + 1)) % 20000)));
+        }));
+  for (std::size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  EXPECT_EQ(before + 20000, miSymbol::count());
+  for (std::size_t t = 0; t < symbols.size(); ++t) {
+    for (int i = 0; i < 20000; ++i) {
+      const std::string expected = "miSymbolTest " + std::to_string((i * (t + 1)) % 20000);
+      ASSERT_EQ(expected, symbols[t][i].str());
+      ASSERT_EQ(symbols[0][(i * (t + 1)) % 20000], symbols[t][i]);
+    }
+  }
+}
+
+TEST(MiPositionTest, Compact)
+{
+  // coordinates, four ints and three symbols
+  EXPECT_LE(sizeof(miPosition), 48);
+
+  miPosition p(miCoordinates(103000, 595600), 1492, 18700, "Oslo - Blindern", 94, 1, "synop");
+  p.setIcao("ENBL");
+  EXPECT_EQ("Oslo - Blindern", p.Name());
+  EXPECT_EQ("synop", p.Group());
+  EXPECT_EQ("ENBL", p.icaoID());
+  EXPECT_TRUE(p.isGrp("synop"));
+  EXPECT_FALSE(p.isGrp("metar"));
+  EXPECT_TRUE(p == std::string("Oslo - Blindern"));
+
+  const miPosition copy = p;
+  EXPECT_EQ(p.Name().data(), copy.Name().data());
+  p.setGroup("metar");
+  EXPECT_EQ("synop", copy.Group());
+  EXPECT_EQ("metar", p.Group());
+}
+
+static miStationRegistry generation(int g, int count)
+{
+  std::vector<miPosition> positions;
+  for (int i = 0; i < count; ++i)
+    positions.push_back(miPosition(miCoordinates(0, 0), g*1000 + i, i, "g" + std::to_string(g)));
+  return miStationRegistry(positions);
+}
+
+TEST(MiConcurrentRegistryTest, Reclaim)
+{
+  miConcurrentRegistry registry(generation(1, 10));
+  {
+    miConcurrentRegistry::Reader reader(registry);
+    {
+      const miConcurrentRegistry::Snapshot snapshot(reader);
+      EXPECT_EQ(1000, (*snapshot)[0].Synop());
+      registry.publish(generation(2, 10));
+      registry.publish(generation(3, 10));
+      // the first one is still pinned
+      EXPECT_EQ(2, registry.retired());
+      EXPECT_EQ(0, snapshot->findSynop(1000));
+    }
+    const miConcurrentRegistry::Snapshot snapshot(reader);
+    EXPECT_EQ(3000, (*snapshot)[0].Synop());
+    registry.synchronize();
+    EXPECT_EQ(0, registry.retired());
+  }
+  // the slot of the destroyed reader is reused
+  miConcurrentRegistry::Reader reader(registry);
+  const miConcurrentRegistry::Snapshot snapshot(reader);
+  EXPECT_EQ(std::string("g3"), (*snapshot)[9].Name());
+}
+
+TEST(MiConcurrentRegistryTest, RepublishNamesBounded)
+{
+  // symbols are never freed, but reloading a changed set of names only
+  // adds the names that were not seen before
+  const int COUNT = 100;
+  const auto renamed = [COUNT](int variant) {
+    std::vector<miPosition> positions;
+    for (int i = 0; i < COUNT; ++i)
+      positions.push_back(miPosition(miCoordinates(0, 0), i, i,
+              "RepublishNamesBounded " + std::to_string(i) + (variant ? " renamed" : ""),
+              0, 0, "RepublishNamesBounded"));
+    return miStationRegistry(positions);
+  };
+
+  miConcurrentRegistry registry(renamed(0));
+  registry.publish(renamed(1));
+  const std::size_t distinct = miSymbol::count();
+  for (int g = 0; g < 100; ++g)
+    registry.publish(renamed(g % 2));
+  registry.synchronize();
+  EXPECT_EQ(distinct, miSymbol::count());
+}
+
+TEST(MiConcurrentRegistryTest, ReadWhilePublishing)
+{
+  const int COUNT = 50, GENERATIONS = 200;
+  miConcurrentRegistry registry(generation(0, COUNT));
+  std::atomic<bool> stop(false);
+  std::atomic<int> errors(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.push_back(std::thread([&]() {
+          miConcurrentRegistry::Reader reader(registry);
+          int last = 0;
+          while (!stop.load()) {
+            const miConcurrentRegistry::Snapshot snapshot(reader);
+            const int g = (*snapshot)[0].Synop() / 1000;
+            if (g < last || snapshot->size() != std::size_t(COUNT)
+                || snapshot->findSynop(g*1000 + COUNT - 1) != std::size_t(COUNT - 1)
+                || (*snapshot)[COUNT - 1].Name() != "g" + std::to_string(g))
+              errors += 1;
+            last = g;
+          }
+        }));
+  }
+  for (int g = 1; g <= GENERATIONS; ++g)
+    registry.publish(generation(g, COUNT));
+  stop = true;
+  for (std::size_t t = 0; t < readers.size(); ++t)
+    readers[t].join();
+  registry.synchronize();
+  EXPECT_EQ(0, errors.load());
+  EXPECT_EQ(0, registry.retired());
+}
@@ -0,0 +1,104 @@
+#include "miLine.h"
+#include "miPredicates.h"
+#include "miRegions.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using miPredicates::Point;
+
+TEST(MiPredicatesTest, Orientation)
+{
+  const Point a(0, 0), b(6000, 0);
+  EXPECT_EQ(1, miPredicates::orientation(a, b, Point(3000, 1)));
+  EXPECT_EQ(-1, miPredicates::orientation(a, b, Point(3000, -1)));
+  EXPECT_EQ(0, miPredicates::orientation(a, b, Point(-12000, 0)));
+
+  // extreme coordinates do not overflow
+  const Point sw(-180*6000, -90*6000), ne(180*6000, 90*6000);
+  EXPECT_EQ(0, miPredicates::orientation(sw, ne, Point(0, 0)));
+  EXPECT_EQ(1, miPredicates::orientation(sw, ne, Point(-1, 0)));
+
+  EXPECT_EQ(Point(39540, 359400), Point(miCoordinates(6.59f, 59.9f)));
+}
+
+TEST(MiPredicatesTest, OnSegment)
+{
+  const Point a(0, 0), b(100, 100);
+  EXPECT_TRUE(miPredicates::onSegment(Point(50, 50), a, b));
+  EXPECT_TRUE(miPredicates::onSegment(a, a, b));
+  EXPECT_TRUE(miPredicates::onSegment(b, a, b));
+  EXPECT_FALSE(miPredicates::onSegment(Point(101, 101), a, b));
+  EXPECT_FALSE(miPredicates::onSegment(Point(50, 51), a, b));
+}
+
+TEST(MiPredicatesTest, SegmentsIntersect)
+{
+  const Point a1(0, 0), a2(100, 0);
+  // proper crossing with a vertical segment
+  EXPECT_TRUE(miPredicates::segmentsIntersect(a1, a2, Point(50, -10), Point(50, 10)));
+  // touching at an end point
+  EXPECT_TRUE(miPredicates::segmentsIntersect(a1, a2, Point(100, 0), Point(100, 10)));
+  EXPECT_TRUE(miPredicates::segmentsIntersect(a1, a2, Point(50, 0), Point(60, 10)));
+  // collinear, overlapping or not
+  EXPECT_TRUE(miPredicates::segmentsIntersect(a1, a2, Point(90, 0), Point(200, 0)));
+  EXPECT_FALSE(miPredicates::segmentsIntersect(a1, a2, Point(101, 0), Point(200, 0)));
+  // parallel
+  EXPECT_FALSE(miPredicates::segmentsIntersect(a1, a2, Point(0, 1), Point(100, 1)));
+  // nearly parallel, missing by one centiminute
+  EXPECT_FALSE(miPredicates::segmentsIntersect(Point(0, 0), Point(1000000, 1),
+          Point(0, 1), Point(999999, 2)));
+  EXPECT_TRUE(miPredicates::segmentsIntersect(Point(0, 0), Point(1000000, 2),
+          Point(0, 1), Point(1000000, 1)));
+}
+
+TEST(MiPredicatesTest, CrossesEdge)
+{
+  const Point o(0, 0), p(0, 100);
+  EXPECT_TRUE(miPredicates::crossesEdge(o, p, Point(-10, 50), Point(10, 50)));
+  EXPECT_FALSE(miPredicates::crossesEdge(o, p, Point(-10, 150), Point(10, 150)));
+  // edges along the segment never count
+  EXPECT_FALSE(miPredicates::crossesEdge(o, p, Point(0, 10), Point(0, 20)));
+
+  // through a corner: both edges or none
+  const Point corner(0, 50);
+  const bool left = miPredicates::crossesEdge(o, p, Point(-10, 40), corner);
+  const bool right = miPredicates::crossesEdge(o, p, corner, Point(10, 40));
+  EXPECT_NE(left, right);
+  EXPECT_FALSE(miPredicates::crossesEdge(o, p, Point(-10, 40), corner)
+      && miPredicates::crossesEdge(o, p, corner, Point(-10, 60)));
+}
+
+TEST(MiPredicatesTest, LineCrossExact)
+{
+  const miLine v(miCoordinates(10.0f, 60.0f), miCoordinates(10.0f, 62.0f));
+  const miLine h(miCoordinates(9.0f, 61.0f), miCoordinates(11.0f, 61.0f));
+  const miLine far(miCoordinates(11.0f, 59.0f), miCoordinates(11.0f, 63.0f));
+  EXPECT_TRUE(v.crossExact(h));
+  EXPECT_TRUE(h.crossExact(v));
+  EXPECT_FALSE(v.crossExact(far));
+  EXPECT_TRUE(far.crossExact(h)); // touches the end of h
+}
+
+TEST(MiPredicatesTest, RegionThroughCorner)
+{
+  // a diamond, looked at from straight south through its lowest corner
+  std::vector<miCoordinates> c;
+  c.push_back(miCoordinates(10.0f, 60.0f));
+  c.push_back(miCoordinates(12.0f, 62.0f));
+  c.push_back(miCoordinates(10.0f, 64.0f));
+  c.push_back(miCoordinates(8.0f, 62.0f));
+  miRegions r("diamond", 1);
+  r.setCorners(c);
+  r.setOrigin(miCoordinates(10.0f, 50.0f));
+  r.setExactPredicates(true);
+  EXPECT_TRUE(r.exactPredicates());
+
+  EXPECT_TRUE(r.isInside(miCoordinates(10.0f, 62.0f)));
+  EXPECT_TRUE(r.isInside(miCoordinates(10.0f, 63.5f)));
+  EXPECT_FALSE(r.isInside(miCoordinates(10.0f, 65.0f)));
+  EXPECT_FALSE(r.isInside(miCoordinates(10.0f, 55.0f)));
+  EXPECT_TRUE(r.isInside(miCoordinates(11.0f, 62.0f)));
+  EXPECT_FALSE(r.isInside(miCoordinates(11.5f, 63.0f)));
+}
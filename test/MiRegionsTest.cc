@@ -0,0 +1,261 @@
+#include "miEdgeBuffer.h"
+#include "miPreparedRegion.h"
+#include "miRegionRaster.h"
+#include "miRegions.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<miCoordinates> square(float lon0, float lat0, float size)
+{
+  std::vector<miCoordinates> c;
+  c.push_back(miCoordinates(lon0,        lat0));
+  c.push_back(miCoordinates(lon0 + size, lat0));
+  c.push_back(miCoordinates(lon0 + size, lat0 + size));
+  c.push_back(miCoordinates(lon0,        lat0 + size));
+  return c;
+}
+
+// a star shaped polygon with corners on whole degrees
+std::vector<miCoordinates> star(int corners, std::mt19937& rng)
+{
+  std::uniform_int_distribution<int> radius(2, 20);
+  std::vector<miCoordinates> c;
+  for (int i = 0; i < corners; ++i) {
+    const double a = 2 * M_PI * i / corners;
+    const int r = radius(rng);
+    c.push_back(miCoordinates(float(std::round(r * std::cos(a))), float(60 + std::round(r * std::sin(a)))));
+  }
+  return c;
+}
+
+} // namespace
+
+TEST(MiRegionsTest, SetCorners)
+{
+  std::vector<miCoordinates> c = square(5, 58, 4);
+  c.push_back(c[1]);
+  c.insert(c.begin() + 2, c[0]);
+  // distinct points that compared equal with the old operator<
+  c.push_back(miCoordinates(10000, 590000));
+  c.push_back(miCoordinates(0, 590100));
+
+  miRegions r("test", 1);
+  r.setCorners(c);
+  ASSERT_EQ(6, r.size());
+  const std::vector<miCoordinates>& corners = r.getCorners();
+  EXPECT_EQ(c[0], corners[0]);
+  EXPECT_EQ(c[1], corners[1]);
+  EXPECT_EQ(c[3], corners[2]);
+  EXPECT_EQ(c[4], corners[3]);
+
+  r.addCorner(c[0]);
+  EXPECT_EQ(6, r.size());
+  r.addCorner(miCoordinates(7.0f, 57.0f));
+  EXPECT_EQ(7, r.size());
+}
+
+TEST(MiRegionsTest, IsIdentical)
+{
+  miRegions a("a", 1), b("b", 2);
+  std::vector<miCoordinates> c = square(5, 58, 4);
+  a.setCorners(c);
+  std::swap(c[0], c[2]);
+  b.setCorners(c);
+  EXPECT_TRUE(a.isIdentical(b));
+}
+
+TEST(MiRegionsTest, IsInside)
+{
+  miRegions r("test", 1);
+  r.setCorners(square(5, 58, 4));
+  r.setOrigin(miCoordinates(0.0f, 0.0f));
+  EXPECT_TRUE(r.isInside(miCoordinates(7.0f, 60.0f)));
+  EXPECT_FALSE(r.isInside(miCoordinates(10.0f, 60.0f)));
+  EXPECT_FALSE(r.isInside(miCoordinates(7.0f, 63.0f)));
+}
+
+TEST(MiRegionsTest, EdgeBufferSquare)
+{
+  miRegions r("test", 1);
+  r.setCorners(square(5, 58, 4));
+  const miEdgeBuffer edges(r);
+  ASSERT_EQ(4, edges.size());
+
+  const miEdgeBuffer::CrossMode modes[] = { miEdgeBuffer::CROSS_ORIENTATION, miEdgeBuffer::CROSS_REFERENCE };
+  for (miEdgeBuffer::CrossMode mode : modes) {
+    const miLine through(miCoordinates(4.0f, 60.0f), miCoordinates(10.0f, 60.0f));
+    EXPECT_EQ(2, edges.countCrossings(through, mode));
+    std::vector<uint64_t> mask;
+    edges.crossings(through, mask, mode);
+    ASSERT_EQ(1, mask.size());
+    EXPECT_EQ(0xau, mask[0]);
+
+    const miLine inside(miCoordinates(6.0f, 59.0f), miCoordinates(8.0f, 61.0f));
+    EXPECT_EQ(0, edges.countCrossings(inside, mode));
+    const miLine half(miCoordinates(7.0f, 60.0f), miCoordinates(7.0f, 65.0f));
+    EXPECT_EQ(1, edges.countCrossings(half, mode));
+  }
+}
+
+TEST(MiRegionsTest, EdgeBufferMatchesReference)
+{
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> quarter(-100, 100);
+  for (int corners : { 3, 17, 64, 65, 200 }) {
+    miRegions r("star", 1);
+    r.setCorners(star(corners, rng));
+    const std::vector<miLine>& border = r.getBorders();
+    const miEdgeBuffer edges(r);
+    ASSERT_EQ(border.size(), edges.size());
+
+    for (int q = 0; q < 200; ++q) {
+      // end points on odd quarter degrees never touch the polygon corners
+      const miLine target(miCoordinates((2*quarter(rng) + 1) / 4.0f, 60 + (2*quarter(rng) + 1) / 4.0f),
+          miCoordinates((2*quarter(rng) + 1) / 4.0f, 60 + (2*quarter(rng) + 1) / 4.0f));
+      int expected = 0;
+      std::vector<uint64_t> expectedMask((border.size() + 63) / 64, 0);
+      for (size_t i = 0; i < border.size(); ++i) {
+        if (border[i].cross(target)) {
+          expected += 1;
+          expectedMask[i / 64] |= uint64_t(1) << (i % 64);
+        }
+      }
+
+      EXPECT_EQ(expected, edges.countCrossings(target, miEdgeBuffer::CROSS_REFERENCE));
+      EXPECT_EQ(expected, edges.countCrossings(target, miEdgeBuffer::CROSS_ORIENTATION));
+      std::vector<uint64_t> mask;
+      edges.crossings(target, mask, miEdgeBuffer::CROSS_REFERENCE);
+      EXPECT_EQ(expectedMask, mask);
+      edges.crossings(target, mask, miEdgeBuffer::CROSS_ORIENTATION);
+      EXPECT_EQ(expectedMask, mask);
+    }
+  }
+}
+
+TEST(MiRegionsTest, PreparedRegionSquare)
+{
+  miRegions r("test", 1);
+  r.setCorners(square(5, 58, 4));
+  const miPreparedRegion prepared(r);
+  EXPECT_TRUE(prepared.contains(miCoordinates(7.0f, 60.0f)));
+  EXPECT_FALSE(prepared.contains(miCoordinates(10.0f, 60.0f)));
+  EXPECT_FALSE(prepared.contains(miCoordinates(7.0f, 63.0f)));
+  EXPECT_FALSE(prepared.contains(miCoordinates(4.0f, 60.0f)));
+
+  // a ray through the corners at 62N and 58N
+  miRegions diamond("diamond", 2);
+  std::vector<miCoordinates> c;
+  c.push_back(miCoordinates(5.0f, 60.0f));
+  c.push_back(miCoordinates(7.0f, 58.0f));
+  c.push_back(miCoordinates(9.0f, 60.0f));
+  c.push_back(miCoordinates(7.0f, 62.0f));
+  diamond.setCorners(c);
+  const miPreparedRegion pd(diamond);
+  EXPECT_TRUE(pd.contains(miCoordinates(6.0f, 60.0f)));
+  EXPECT_FALSE(pd.contains(miCoordinates(4.0f, 60.0f)));
+  EXPECT_FALSE(pd.contains(miCoordinates(10.0f, 60.0f)));
+
+  const miPreparedRegion none;
+  EXPECT_TRUE(none.empty());
+  EXPECT_FALSE(none.contains(miCoordinates(7.0f, 60.0f)));
+}
+
+TEST(MiRegionsTest, PreparedRegionMatchesIsInside)
+{
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> quarter(-100, 100);
+  for (int corners : { 5, 17, 200 }) {
+    miRegions r("star", 1);
+    r.setCorners(star(corners, rng));
+    r.setOrigin(miCoordinates(-100.0f, -80.0f));
+    r.setExactPredicates(true);
+    const miPreparedRegion prepared(r);
+    EXPECT_GE(prepared.bands(), 1);
+
+    std::vector<miCoordinates> points;
+    for (int q = 0; q < 1000; ++q) {
+      const miCoordinates p((2*quarter(rng) + 1) / 4.0f, 60 + (2*quarter(rng) + 1) / 4.0f);
+      // the result is unspecified for points on the border
+      bool onBorder = false;
+      for (const miLine& l : r.getBorders())
+        onBorder |= miPredicates::onSegment(miPredicates::Point(p), l.pBegin(), l.pEnd());
+      if (!onBorder)
+        points.push_back(p);
+    }
+
+    std::vector<char> inside;
+    prepared.contains(points, inside);
+    ASSERT_EQ(points.size(), inside.size());
+    int count = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+      EXPECT_EQ(r.isInside(points[i]), bool(inside[i])) << points[i];
+      EXPECT_EQ(r.isInside(points[i]), prepared.contains(points[i]));
+      count += inside[i];
+    }
+    EXPECT_GT(count, 0);
+  }
+}
+
+TEST(MiRegionsTest, RasterMatchesPreparedRegion)
+{
+  std::mt19937 rng(13);
+  std::uniform_int_distribution<int> cmin(-26*6000, 26*6000);
+  for (int corners : { 5, 40, 300 }) {
+    miRegions r("star", 1);
+    r.setCorners(star(corners, rng));
+    const miPreparedRegion prepared(r);
+
+    std::vector<miCoordinates> points;
+    for (int q = 0; q < 2000; ++q)
+      points.push_back(miCoordinates(coor(cmin(rng) / 6000.0f), coor(60 + cmin(rng) / 6000.0f)));
+    // corners and points on the border
+    for (miLine l : r.getBorders()) {
+      points.push_back(l.begin());
+      points.push_back(l.middle());
+    }
+
+    std::vector<char> expected;
+    prepared.contains(points, expected);
+
+    const unsigned int cells[] = { 1, 4, 64, 256 };
+    for (unsigned int c : cells) {
+      const miRegionRaster raster(r, c, 4);
+      miRegionRaster::Stats stats;
+      std::vector<char> inside;
+      raster.contains(points, inside, &stats);
+      EXPECT_EQ(expected, inside) << corners << " corners, " << c << " cells";
+      EXPECT_EQ(points.size(), stats.queries());
+      EXPECT_GT(raster.memoryUsage(), 0);
+      if (c >= 64) {
+        EXPECT_GT(stats.hitRate(), 0.5);
+      }
+      for (size_t i = 0; i < points.size(); i += 97)
+        EXPECT_EQ(bool(expected[i]), raster.contains(points[i]));
+    }
+  }
+}
+
+TEST(MiRegionsTest, RasterSquare)
+{
+  miRegions r("test", 1);
+  r.setCorners(square(5, 58, 4));
+  const miRegionRaster raster(r, 16, 4);
+  miRegionRaster::Stats stats;
+  EXPECT_TRUE(raster.contains(miCoordinates(7.0f, 60.0f), &stats));
+  EXPECT_FALSE(raster.contains(miCoordinates(10.0f, 60.0f), &stats));
+  EXPECT_FALSE(raster.contains(miCoordinates(-10.0f, 60.0f), &stats));
+  EXPECT_EQ(3, stats.cellHits);
+  EXPECT_EQ(1.0, stats.hitRate());
+  EXPECT_EQ(60, raster.borderCells());
+
+  const miRegionRaster none;
+  EXPECT_FALSE(none.contains(miCoordinates(7.0f, 60.0f)));
+  EXPECT_EQ(0, none.borderCells());
+  EXPECT_EQ(0, none.memoryUsage());
+}
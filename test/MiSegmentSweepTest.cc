@@ -0,0 +1,109 @@
+#include "miRegions.h"
+#include "miSegmentSweep.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+// lines on a coarse grid, so that touching and collinear lines are common
+std::vector<miLine> randomLines(size_t count, std::mt19937& rng)
+{
+  std::uniform_int_distribution<int> d(0, 8);
+  std::vector<miLine> lines;
+  for (size_t i = 0; i < count; ++i)
+    lines.push_back(miLine(miCoordinates(float(d(rng)), float(50 + d(rng))),
+            miCoordinates(float(d(rng)), float(50 + d(rng)))));
+  return lines;
+}
+
+std::vector<miSegmentSweep::Pair> bruteForce(const std::vector<miLine>& a, const std::vector<miLine>& b, bool same)
+{
+  std::vector<miSegmentSweep::Pair> pairs;
+  for (size_t i = 0; i < a.size(); ++i)
+    for (size_t j = same ? i + 1 : 0; j < b.size(); ++j)
+      if (a[i].crossExact(b[j]))
+        pairs.push_back(miSegmentSweep::Pair(i, j));
+  return pairs;
+}
+
+miRegions region(const std::vector<miCoordinates>& corners)
+{
+  miRegions r("test", 1);
+  r.setCorners(corners);
+  return r;
+}
+
+} // namespace
+
+TEST(MiSegmentSweepTest, MatchesBruteForce)
+{
+  std::mt19937 rng(3);
+  for (int round = 0; round < 20; ++round) {
+    const std::vector<miLine> a = randomLines(40, rng), b = randomLines(30, rng);
+
+    const miSegmentSweep one(a);
+    EXPECT_EQ(bruteForce(a, a, true), one.intersections());
+    EXPECT_EQ(!one.intersections().empty(), one.anyIntersection());
+
+    const miSegmentSweep two(a, b);
+    const std::vector<miSegmentSweep::Pair> expected = bruteForce(a, b, false);
+    EXPECT_EQ(expected, two.intersections());
+    miSegmentSweep::Pair first;
+    ASSERT_EQ(!expected.empty(), two.anyIntersection(first));
+    if (!expected.empty()) {
+      EXPECT_TRUE(a[first.first].crossExact(b[first.second]));
+    }
+  }
+}
+
+TEST(MiSegmentSweepTest, NoIntersections)
+{
+  std::vector<miLine> lines;
+  for (int i = 0; i < 10; ++i)
+    lines.push_back(miLine(miCoordinates(float(i), 60.0f), miCoordinates(float(i), 61.0f)));
+  const miSegmentSweep sweep(lines);
+  EXPECT_FALSE(sweep.anyIntersection());
+  EXPECT_TRUE(sweep.intersections().empty());
+  EXPECT_FALSE(miSegmentSweep(std::vector<miLine>()).anyIntersection());
+}
+
+TEST(MiSegmentSweepTest, SharedEndpoints)
+{
+  const miCoordinates a(0.0f, 60.0f), b(1.0f, 60.0f), c(2.0f, 60.0f), d(1.0f, 61.0f);
+  std::vector<miLine> lines;
+  lines.push_back(miLine(a, b));
+  lines.push_back(miLine(b, d));
+  EXPECT_TRUE(miSegmentSweep(lines).anyIntersection());
+  EXPECT_FALSE(miSegmentSweep(lines, miSegmentSweep::IGNORE_SHARED_ENDPOINTS).anyIntersection());
+
+  // collinear, turning back over the first line
+  lines[1] = miLine(b, miCoordinates(0.5f, 60.0f));
+  EXPECT_TRUE(miSegmentSweep(lines, miSegmentSweep::IGNORE_SHARED_ENDPOINTS).anyIntersection());
+
+  // collinear, continuing
+  lines[1] = miLine(b, c);
+  EXPECT_FALSE(miSegmentSweep(lines, miSegmentSweep::IGNORE_SHARED_ENDPOINTS).anyIntersection());
+}
+
+TEST(MiSegmentSweepTest, RegionIsSimple)
+{
+  std::vector<miCoordinates> c;
+  c.push_back(miCoordinates(5.0f, 58.0f));
+  c.push_back(miCoordinates(9.0f, 58.0f));
+  c.push_back(miCoordinates(9.0f, 62.0f));
+  c.push_back(miCoordinates(5.0f, 62.0f));
+  const miRegions square = region(c);
+  EXPECT_TRUE(square.isSimple());
+
+  std::swap(c[2], c[3]);
+  const miRegions bowtie = region(c);
+  EXPECT_FALSE(bowtie.isSimple());
+
+  const std::vector<miSegmentSweep::Pair> crossings = square.borderCrossings(bowtie);
+  EXPECT_FALSE(crossings.empty());
+  for (size_t i = 0; i < crossings.size(); ++i)
+    EXPECT_TRUE(square.getBorders()[crossings[i].first].crossExact(bowtie.getBorders()[crossings[i].second]));
+}
@@ -0,0 +1,462 @@
+#include "miConcurrentRegistry.h"
+#include "miCoordinates.h"
+#include "miEdgeBuffer.h"
+#include "miGeodesic.h"
+#include "miPositionLoader.h"
+#include "miPositionTable.h"
+#include "miPreparedRegion.h"
+#include "miRegionRaster.h"
+#include "miRegions.h"
+#include "miSegmentSweep.h"
+#include "miStationCatalog.h"
+#include "miStationRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+double elapsedNs(const clock_type::time_point& start)
+{
+  return std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+}
+
+void report(const char* what, double ns, size_t count, double checksum)
+{
+  std::printf("%-40s %10.1f ns/op   (checksum %g)\n", what, ns / count, checksum);
+}
+
+void benchDistances()
+{
+  const size_t N_ORIGINS = 200, N_POINTS = 20000;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> lon(-M_PI, M_PI), lat(-M_PI/2, M_PI/2);
+
+  std::vector<LonLat> origins;
+  for (size_t i = 0; i < N_ORIGINS; ++i)
+    origins.push_back(LonLat(lon(rng), lat(rng)));
+  std::vector<double> lons(N_POINTS), lats(N_POINTS), distances(N_POINTS);
+  for (size_t i = 0; i < N_POINTS; ++i) {
+    lons[i] = lon(rng);
+    lats[i] = lat(rng);
+  }
+  const size_t count = N_ORIGINS * N_POINTS;
+
+  double sum = 0;
+  clock_type::time_point start = clock_type::now();
+  for (size_t o = 0; o < N_ORIGINS; ++o)
+    for (size_t i = 0; i < N_POINTS; ++i)
+      sum += origins[o].distanceTo(LonLat(lons[i], lats[i]));
+  report("sphere LonLat::distanceTo", elapsedNs(start), count, sum);
+
+  sum = 0;
+  start = clock_type::now();
+  for (size_t o = 0; o < N_ORIGINS; ++o) {
+    origins[o].distancesTo(&lons[0], &lats[0], N_POINTS, &distances[0]);
+    for (size_t i = 0; i < N_POINTS; ++i)
+      sum += distances[i];
+  }
+  report("sphere LonLat::distancesTo", elapsedNs(start), count, sum);
+
+  const miGeodesic g;
+  sum = 0;
+  start = clock_type::now();
+  for (size_t o = 0; o < N_ORIGINS; ++o)
+    for (size_t i = 0; i < N_POINTS; ++i) {
+      const double d = g.distance(origins[o], LonLat(lons[i], lats[i]));
+      if (!std::isnan(d))
+        sum += d;
+    }
+  report("WGS84 miGeodesic::distance", elapsedNs(start), count, sum);
+
+  sum = 0;
+  start = clock_type::now();
+  for (size_t o = 0; o < N_ORIGINS; ++o) {
+    miGeodesicOrigin(origins[o]).distancesTo(&lons[0], &lats[0], N_POINTS, &distances[0]);
+    for (size_t i = 0; i < N_POINTS; ++i)
+      if (!std::isnan(distances[i]))
+        sum += distances[i];
+  }
+  report("WGS84 miGeodesicOrigin::distancesTo", elapsedNs(start), count, sum);
+
+  // the distances to the last origin, along one azimuth from each origin
+  std::vector<LonLat> positions(N_POINTS);
+  sum = 0;
+  start = clock_type::now();
+  for (size_t o = 0; o < N_ORIGINS; ++o)
+    for (size_t i = 0; i < N_POINTS; ++i)
+      sum += g.direct(origins[o], lons[o], distances[i]).lat();
+  report("WGS84 miGeodesic::direct", elapsedNs(start), count, sum);
+
+  sum = 0;
+  start = clock_type::now();
+  for (size_t o = 0; o < N_ORIGINS; ++o) {
+    miGeodesicLine(origins[o], lons[o]).positions(&distances[0], N_POINTS, &positions[0]);
+    for (size_t i = 0; i < N_POINTS; ++i)
+      sum += positions[i].lat();
+  }
+  report("WGS84 miGeodesicLine::positions", elapsedNs(start), count, sum);
+}
+
+void benchLoader()
+{
+  const size_t N_STATIONS = 100000;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> lon(-180, 180), lat(-90, 90);
+  std::ostringstream text;
+  for (size_t i = 0; i < N_STATIONS; ++i)
+    text << (1000 + i) << ';' << i << ";station number " << i << ';' << lon(rng) << ';' << lat(rng)
+         << ';' << (i % 1000) << ';' << (i % 5) << ";synop;E" << char('A' + i % 26) << "XY\n";
+  const std::string catalog = text.str();
+
+  std::vector<miPosition> positions;
+  const unsigned int threads[] = { 1, 0 };
+  for (unsigned int t : threads) {
+    positions.clear();
+    const clock_type::time_point start = clock_type::now();
+    miPositionLoader(';', t).load(catalog, positions);
+    report(t == 1 ? "miPositionLoader::load, 1 thread" : "miPositionLoader::load, all threads",
+        elapsedNs(start), N_STATIONS, positions.size());
+  }
+
+  const std::string filename = "/tmp/pudatatypes_bench.cat";
+  miStationCatalog::write(filename, miPositionTable(positions));
+  miStationCatalog binary;
+  const clock_type::time_point start = clock_type::now();
+  binary.open(filename);
+  report("miStationCatalog::open", elapsedNs(start), N_STATIONS, binary.size());
+  std::remove(filename.c_str());
+}
+
+void benchTable()
+{
+  const size_t N_STATIONS = 100000, N_QUERIES = 50;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> lon(-180, 180), lat(-90, 90);
+  const char* groups[] = { "synop", "metar", "ship", "buoy" };
+  std::vector<miPosition> positions;
+  for (size_t i = 0; i < N_STATIONS; ++i)
+    positions.push_back(miPosition(miCoordinates(lon(rng), lat(rng)), i, i,
+            "station number " + std::to_string(i), 0, 0, groups[i % 4]));
+  const miPositionTable table(positions);
+  const miCoordinates nw(-10.f, 70.f), se(30.f, 50.f), c(10.7f, 59.9f);
+  const size_t count = N_QUERIES * N_STATIONS;
+
+  size_t found = 0;
+  clock_type::time_point start = clock_type::now();
+  for (size_t q = 0; q < N_QUERIES; ++q)
+    for (size_t i = 0; i < N_STATIONS; ++i)
+      found += positions[i].isInRect(nw, se);
+  report("vector<miPosition> isInRect", elapsedNs(start), count, found);
+
+  std::vector<size_t> indices;
+  found = 0;
+  start = clock_type::now();
+  for (size_t q = 0; q < N_QUERIES; ++q) {
+    table.inRect(nw, se, indices);
+    found += indices.size();
+  }
+  report("miPositionTable::inRect", elapsedNs(start), count, found);
+
+  found = 0;
+  start = clock_type::now();
+  for (size_t q = 0; q < N_QUERIES; ++q)
+    for (size_t i = 0; i < N_STATIONS; ++i)
+      found += positions[i].isGrp("metar");
+  report("vector<miPosition> isGrp", elapsedNs(start), count, found);
+
+  found = 0;
+  start = clock_type::now();
+  for (size_t q = 0; q < N_QUERIES; ++q) {
+    table.inGroup("metar", indices);
+    found += indices.size();
+  }
+  report("miPositionTable::inGroup", elapsedNs(start), count, found);
+
+  found = 0;
+  start = clock_type::now();
+  for (size_t q = 0; q < N_QUERIES; ++q)
+    for (size_t i = 0; i < N_STATIONS; ++i)
+      found += (positions[i].distance(c) <= 1000);
+  report("vector<miPosition> distance", elapsedNs(start), count, found);
+
+  found = 0;
+  start = clock_type::now();
+  for (size_t q = 0; q < N_QUERIES; ++q) {
+    table.withinKm(c, 1000, indices);
+    found += indices.size();
+  }
+  report("miPositionTable::withinKm", elapsedNs(start), count, found);
+}
+
+void benchRegistry()
+{
+  const size_t N_STATIONS = 20000, N_LOOKUPS = 200000;
+  std::vector<miPosition> positions;
+  for (size_t i = 0; i < N_STATIONS; ++i) {
+    positions.push_back(miPosition(miCoordinates(0.f, 0.f), 1000 + 3*i, i,
+            "station number " + std::to_string(i)));
+    positions.back().setIcao("E" + std::to_string(i));
+  }
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<size_t> station(0, N_STATIONS - 1);
+  std::vector<size_t> wanted(N_LOOKUPS);
+  std::vector<std::string> icaos(N_LOOKUPS);
+  for (size_t i = 0; i < N_LOOKUPS; ++i) {
+    wanted[i] = station(rng);
+    icaos[i] = positions[wanted[i]].icaoID();
+  }
+
+  size_t sum = 0;
+  clock_type::time_point start = clock_type::now();
+  for (size_t i = 0; i < N_LOOKUPS / 100; ++i)
+    sum += std::find(positions.begin(), positions.end(), int(wanted[i])) - positions.begin();
+  report("std::find by dbKey", elapsedNs(start), N_LOOKUPS / 100, sum);
+
+  start = clock_type::now();
+  const miStationRegistry registry(positions);
+  report("miStationRegistry build", elapsedNs(start), N_STATIONS, registry.size());
+
+  sum = 0;
+  start = clock_type::now();
+  for (size_t i = 0; i < N_LOOKUPS; ++i)
+    sum += registry.findDbKey(wanted[i]);
+  report("miStationRegistry::findDbKey", elapsedNs(start), N_LOOKUPS, sum);
+
+  sum = 0;
+  start = clock_type::now();
+  for (size_t i = 0; i < N_LOOKUPS; ++i)
+    sum += registry.findIcao(icaos[i]);
+  report("miStationRegistry::findIcao", elapsedNs(start), N_LOOKUPS, sum);
+}
+
+void benchSort()
+{
+  const size_t N_STATIONS = 100000;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> lon(-180, 180), lat(-90, 90);
+  std::vector<miPosition> positions;
+  for (size_t i = 0; i < N_STATIONS; ++i)
+    positions.push_back(miPosition(miCoordinates(lon(rng), lat(rng)), i, i, "station " + std::to_string(i)));
+  const miCoordinates origo(10.7f, 59.9f);
+
+  std::vector<miPosition> sorted = positions;
+  clock_type::time_point start = clock_type::now();
+  miPosition::setSortMode(miPosition::sort_distance);
+  miPosition::setSortOrigo(origo);
+  std::sort(sorted.begin(), sorted.end());
+  report("std::sort sort_distance", elapsedNs(start), N_STATIONS, sorted.front().DbKey());
+
+  const unsigned int threads[] = { 1, 0 };
+  for (unsigned int t : threads) {
+    sorted = positions;
+    start = clock_type::now();
+    sortPositions(sorted, miPosition::sort_distance, origo, t);
+    report(t == 1 ? "sortPositions sort_distance, 1 thread" : "sortPositions sort_distance, all threads",
+        elapsedNs(start), N_STATIONS, sorted.front().DbKey());
+  }
+}
+
+void benchConcurrentRegistry()
+{
+  const size_t N_STATIONS = 10000;
+  std::vector<miPosition> positions;
+  for (size_t i = 0; i < N_STATIONS; ++i)
+    positions.push_back(miPosition(miCoordinates(0.f, 0.f), 1000 + i, i, "station " + std::to_string(i)));
+  const miStationRegistry catalog(positions);
+
+  const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned int threads = 1; threads <= 2*hardware; threads *= 2) {
+    miConcurrentRegistry registry(catalog);
+    std::atomic<bool> stop(false);
+    std::vector<size_t> lookups(threads);
+    std::vector<std::thread> readers;
+    for (unsigned int t = 0; t < threads; ++t) {
+      readers.push_back(std::thread([&, t]() {
+            miConcurrentRegistry::Reader reader(registry);
+            size_t n = 0, synop = 1000 + t;
+            while (!stop.load(std::memory_order_relaxed)) {
+              const miConcurrentRegistry::Snapshot snapshot(reader);
+              n += (snapshot->findSynop(synop) != miStationRegistry::NONE);
+              synop = 1000 + (synop * 7919) % N_STATIONS;
+            }
+            lookups[t] = n;
+          }));
+    }
+
+    // reload every 20 ms while the readers run
+    const clock_type::time_point start = clock_type::now();
+    int reloads = 0;
+    while (elapsedNs(start) < 500e6) {
+      registry.publish(catalog);
+      reloads += 1;
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    stop = true;
+    for (unsigned int t = 0; t < threads; ++t)
+      readers[t].join();
+    const double seconds = elapsedNs(start) / 1e9;
+
+    size_t total = 0;
+    for (unsigned int t = 0; t < threads; ++t)
+      total += lookups[t];
+    std::printf("miConcurrentRegistry, %2u readers         %10.1f Mlookups/s (%d reloads)\n",
+        threads, total / seconds / 1e6, reloads);
+  }
+}
+
+void benchEdgeBuffer()
+{
+  const size_t N_CORNERS = 1000, N_QUERIES = 2000;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> radius(5, 20), lon(-30, 30), lat(30, 90);
+  std::vector<miCoordinates> corners;
+  for (size_t i = 0; i < N_CORNERS; ++i) {
+    const double a = 2 * M_PI * i / N_CORNERS;
+    const float r = radius(rng);
+    corners.push_back(miCoordinates(float(r * std::cos(a)), float(60 + r * std::sin(a))));
+  }
+  miRegions region("bench", 1);
+  region.setCorners(corners);
+  const miEdgeBuffer edges(region);
+
+  std::vector<miLine> targets;
+  for (size_t i = 0; i < N_QUERIES; ++i)
+    targets.push_back(miLine(miCoordinates(lon(rng), lat(rng)), miCoordinates(lon(rng), lat(rng))));
+
+  const size_t n = N_QUERIES * edges.size();
+  const std::vector<miLine>& border = region.getBorders();
+  clock_type::time_point start = clock_type::now();
+  double sum = 0;
+  for (const miLine& t : targets)
+    for (const miLine& b : border)
+      sum += b.cross(t);
+  report("miLine::cross", elapsedNs(start), n, sum);
+
+  start = clock_type::now();
+  sum = 0;
+  for (const miLine& t : targets)
+    sum += edges.countCrossings(t, miEdgeBuffer::CROSS_ORIENTATION);
+  report("miEdgeBuffer::countCrossings", elapsedNs(start), n, sum);
+
+  start = clock_type::now();
+  sum = 0;
+  std::vector<uint64_t> mask;
+  for (const miLine& t : targets) {
+    edges.crossings(t, mask, miEdgeBuffer::CROSS_ORIENTATION);
+    sum += mask[0] & 1;
+  }
+  report("miEdgeBuffer::crossings", elapsedNs(start), n, sum);
+}
+
+void benchRegionInside()
+{
+  const size_t N_CORNERS = 200, N_POINTS = 20000;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> radius(5, 20), lon(-25, 25), lat(35, 85);
+  std::vector<miCoordinates> corners;
+  for (size_t i = 0; i < N_CORNERS; ++i) {
+    const double a = 2 * M_PI * i / N_CORNERS;
+    const float r = radius(rng);
+    corners.push_back(miCoordinates(float(r * std::cos(a)), float(60 + r * std::sin(a))));
+  }
+  miRegions region("bench", 1);
+  region.setCorners(corners);
+  region.setOrigin(miCoordinates(-40.0f, 0.0f));
+
+  std::vector<miCoordinates> points;
+  for (size_t i = 0; i < N_POINTS; ++i)
+    points.push_back(miCoordinates(lon(rng), lat(rng)));
+
+  const bool exact[] = { false, true };
+  for (bool e : exact) {
+    region.setExactPredicates(e);
+    const clock_type::time_point start = clock_type::now();
+    double inside = 0;
+    for (const miCoordinates& p : points)
+      inside += region.isInside(p);
+    report(e ? "miRegions::isInside, exact" : "miRegions::isInside, miLine::cross",
+        elapsedNs(start), N_POINTS, inside);
+  }
+
+  clock_type::time_point start = clock_type::now();
+  const miPreparedRegion prepared(region);
+  report("miPreparedRegion, construction", elapsedNs(start), 1, prepared.bands());
+
+  start = clock_type::now();
+  std::vector<char> inside;
+  prepared.contains(points, inside);
+  report("miPreparedRegion::contains", elapsedNs(start), N_POINTS,
+      std::count(inside.begin(), inside.end(), 1));
+
+  const unsigned int cells[] = { 16, 64, 256 };
+  for (unsigned int c : cells) {
+    const miRegionRaster raster(region, c);
+    miRegionRaster::Stats stats;
+    start = clock_type::now();
+    raster.contains(points, inside, &stats);
+    const double ns = elapsedNs(start);
+    std::printf("miRegionRaster::contains, %3u cells     %10.1f ns/op   (hit rate %.3f, %zu bytes)\n",
+        c, ns / N_POINTS, stats.hitRate(), raster.memoryUsage());
+  }
+}
+
+void benchSegmentSweep()
+{
+  // a ragged coastline-like polygon
+  const size_t N_CORNERS = 10000;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> radius(9.5, 10.5);
+  std::vector<miCoordinates> corners;
+  for (size_t i = 0; i < N_CORNERS; ++i) {
+    const double a = 2 * M_PI * i / N_CORNERS;
+    const float r = radius(rng);
+    corners.push_back(miCoordinates(float(2 * r * std::cos(a)), float(60 + r * std::sin(a))));
+  }
+  miRegions region("bench", 1);
+  region.setCorners(corners);
+  const std::vector<miLine>& border = region.getBorders();
+
+  clock_type::time_point start = clock_type::now();
+  const bool simple = region.isSimple();
+  report("miRegions::isSimple (per edge)", elapsedNs(start), border.size(), simple);
+
+  start = clock_type::now();
+  const size_t count = miSegmentSweep(border).intersections().size();
+  report("miSegmentSweep::intersections (per edge)", elapsedNs(start), border.size(), count);
+
+  // all pairs with miLine::cross, on a part of the border
+  const size_t N_BRUTE = 2000;
+  start = clock_type::now();
+  size_t brute = 0;
+  for (size_t i = 0; i < N_BRUTE; ++i)
+    for (size_t j = i + 1; j < border.size(); ++j)
+      brute += border[i].cross(border[j]);
+  report("all pairs miLine::cross (per edge)", elapsedNs(start) * border.size() / N_BRUTE,
+      border.size(), brute);
+}
+
+} // namespace
+
+int main()
+{
+  benchDistances();
+  benchLoader();
+  benchTable();
+  benchRegistry();
+  benchSort();
+  benchConcurrentRegistry();
+  benchEdgeBuffer();
+  benchRegionInside();
+  benchSegmentSweep();
+  return 0;
+}
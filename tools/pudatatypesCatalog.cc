@@ -0,0 +1,94 @@
+/*
+  libpuDatatypes - Diverse datatypes: Regions, coordinates and alike
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+// convert a text station catalog to the binary miStationCatalog format
+
+#include "miPositionLoader.h"
+#include "miPositionTable.h"
+#include "miStationCatalog.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+int usage(const char* argv0)
+{
+  std::cerr << "usage: " << argv0 << " [-d delimiter] stations.txt stations.cat\n"
+            << "       " << argv0 << " -c stations.cat\n"
+            << "The text format is described in miPositionLoader.h; -c validates a binary catalog.\n";
+  return 1;
+}
+
+int check(const char* filename)
+{
+  miStationCatalog catalog;
+  if (!catalog.open(filename)) {
+    std::cerr << filename << ": " << catalog.error() << std::endl;
+    return 1;
+  }
+  std::cout << filename << ": " << catalog.size() << " stations" << std::endl;
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  char delimiter = ';';
+  int a = 1;
+  if (argc == 3 && std::strcmp(argv[1], "-c") == 0)
+    return check(argv[2]);
+  if (argc == 5 && std::strcmp(argv[1], "-d") == 0) {
+    if (std::strlen(argv[2]) != 1)
+      return usage(argv[0]);
+    delimiter = argv[2][0];
+    a = 3;
+  }
+  if (argc != a + 2)
+    return usage(argv[0]);
+
+  const char* input = argv[a];
+  const char* output = argv[a+1];
+  std::vector<miPosition> positions;
+  std::size_t bad = 0;
+  if (!miPositionLoader(delimiter).loadFile(input, positions, &bad)) {
+    std::cerr << input << ": cannot read" << std::endl;
+    return 1;
+  }
+  if (bad > 0)
+    std::cerr << input << ": skipped " << bad << " bad lines" << std::endl;
+
+  std::string error;
+  if (!miStationCatalog::write(output, miPositionTable(positions), &error)) {
+    std::cerr << output << ": " << error << std::endl;
+    return 1;
+  }
+  return check(output);
+}